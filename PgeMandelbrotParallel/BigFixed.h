@@ -0,0 +1,172 @@
+/*
+This code is:
+
+Copyright 2024 - 2025 Frank B. Jakobsen
+
+It is released under the same license as PgeMandelbrotParallel.cpp, the OLC 3
+
+Arbitrary precision fixed point numbers, for the reference orbits of deep zooms.
+
+A number is a vector of 64 bit limbs in two's complement, least significant first.
+The most significant limb is the integer part, and the rest are the fraction,
+so the precision is chosen at runtime by the number of limbs.
+The values of the Mandelbrot iteration are bounded, so there is no need for an exponent.
+All operands of an operation must have the same number of limbs.
+
+Like Fixed128, all arithmetic is integer, and multiplication truncates the magnitude of the exact product.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+#endif
+
+class BigFixed
+{
+public:
+	// The number of limbs needed for at least nFractionBits bits of fraction
+	static int LimbsForFractionBits(int nFractionBits)
+	{
+		return 1 + (std::max(nFractionBits, 1) + 63) / 64;
+	}
+
+	explicit BigFixed(int nLimbs = 2) : limbs(nLimbs, 0) {}
+
+	// Exact, as long as the bits of d are within the resolution, and truncated toward zero otherwise
+	BigFixed(double d, int nLimbs) : limbs(nLimbs, 0)
+	{
+		int exponent = 0;
+		double mantissa = std::frexp(std::abs(d), &exponent);	// |d| = mantissa * 2^exponent, mantissa in [0.5, 1)
+		uint64_t bits = (uint64_t)std::ldexp(mantissa, 53);
+		int shift = exponent - 53 + 64 * (nLimbs - 1);			// Bit position of the mantissa in the limbs
+
+		for (int i = 0; i < nLimbs; i++)
+		{
+			int offset = shift - 64 * i;	// Position of the mantissa relative to limb i
+			if (offset >= 64 || offset <= -64)
+				continue;
+			limbs[i] = offset >= 0 ? bits << offset : bits >> -offset;
+		}
+
+		if (d < 0)
+			Negate();
+	}
+
+	// From the limbs of another number, as given by LimbData
+	BigFixed(const uint64_t* pLimbs, int nLimbs) : limbs(pLimbs, pLimbs + nLimbs) {}
+
+	int Limbs() const { return (int)limbs.size(); }
+
+	const uint64_t* LimbData() const { return limbs.data(); }
+
+	bool IsNegative() const { return (int64_t)limbs.back() < 0; }
+
+	// Rounded toward zero to double
+	double ToDouble() const
+	{
+		BigFixed m = IsNegative() ? -*this : *this;
+		int top = Limbs() - 1;
+		double d = 0;
+		for (int i = std::max(top - 2, 0); i <= top; i++)
+			d += std::ldexp((double)m.limbs[i], 64 * (i - top));
+		return IsNegative() ? -d : d;
+	}
+
+	friend BigFixed operator+(const BigFixed& a, const BigFixed& b)
+	{
+		BigFixed r(a.Limbs());
+		uint64_t carry = 0;
+		for (int i = 0; i < a.Limbs(); i++)
+		{
+			uint64_t s = a.limbs[i] + carry;
+			carry = s < carry ? 1 : 0;
+			r.limbs[i] = s + b.limbs[i];
+			carry += r.limbs[i] < s ? 1 : 0;
+		}
+		return r;
+	}
+
+	friend BigFixed operator-(const BigFixed& a)
+	{
+		BigFixed r = a;
+		r.Negate();
+		return r;
+	}
+
+	friend BigFixed operator-(const BigFixed& a, const BigFixed& b)
+	{
+		return a + -b;
+	}
+
+	// The exact product of the magnitudes, shifted down by the fraction limbs
+	friend BigFixed operator*(const BigFixed& a, const BigFixed& b)
+	{
+		int n = a.Limbs();
+		BigFixed ma = a.IsNegative() ? -a : a;
+		BigFixed mb = b.IsNegative() ? -b : b;
+
+		// Schoolbook multiplication, only the limbs from n - 1 are kept, but the lower ones give the carries
+		std::vector<uint64_t> product(2 * n, 0);
+		for (int i = 0; i < n; i++)
+		{
+			uint64_t carry = 0;
+			for (int j = 0; j < n; j++)
+			{
+				uint64_t hi;
+				uint64_t lo = Multiply64(ma.limbs[i], mb.limbs[j], hi);
+				lo += carry;
+				hi += lo < carry ? 1 : 0;
+				product[i + j] += lo;
+				hi += product[i + j] < lo ? 1 : 0;
+				carry = hi;
+			}
+			product[i + n] = carry;
+		}
+
+		BigFixed r(n);
+		for (int i = 0; i < n; i++)
+			r.limbs[i] = product[i + n - 1];
+
+		if (a.IsNegative() != b.IsNegative())
+			r.Negate();
+		return r;
+	}
+
+private:
+	std::vector<uint64_t> limbs;
+
+	void Negate()
+	{
+		uint64_t carry = 1;
+		for (auto& limb : limbs)
+		{
+			limb = ~limb + carry;
+			carry = (carry && limb == 0) ? 1 : 0;
+		}
+	}
+
+	// The full 128 bit product of two 64 bit values, the high half returned in hi
+	static uint64_t Multiply64(uint64_t a, uint64_t b, uint64_t& hi)
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 p = (unsigned __int128)a * b;
+		hi = (uint64_t)(p >> 64);
+		return (uint64_t)p;
+#elif defined(_MSC_VER) && defined(_M_X64)
+		return _umul128(a, b, &hi);
+#else
+		uint64_t a0 = (uint32_t)a, a1 = a >> 32;
+		uint64_t b0 = (uint32_t)b, b1 = b >> 32;
+		uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+		uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+		hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+		return (mid << 32) | (uint32_t)p00;
+#endif
+	}
+};
@@ -0,0 +1,190 @@
+/*
+This code is:
+
+Copyright 2024 - 2025 Frank B. Jakobsen
+
+It is released under the same license as PgeMandelbrotParallel.cpp, the OLC 3
+
+Double-double arithmetic, a number stored as the unevaluated sum of two doubles, hi + lo,
+where lo is below half an ulp of hi. This gives about 106 bits of mantissa, at the cost of
+some 10-20 double operations for each operation.
+
+The type is a template on the underlying type T, which is double for the scalar kernels,
+or a std::experimental::simd of doubles for the SIMD kernels. Only operators, abs and copysign
+are used on T, so the same code works for both.
+
+The error free transformations need IEEE double rounding of each operation,
+so the compiler must not contract multiplies and adds into FMA instructions.
+GCC contracts by default where the target has FMA, such as AArch64, so the build scripts
+pass -ffp-contract=off, and the pragmas below turn contraction off for MSVC and clang.
+Where the hardware has FMA anyway, TwoProd uses it, which is exact whatever the compiler does
+*/
+
+#pragma once
+
+#include <cmath>
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+#pragma fp_contract (off)
+#endif
+
+template <typename T>
+struct DoubleDoubleT
+{
+	T hi;
+	T lo;
+
+	DoubleDoubleT() : hi(0), lo(0) {}
+	DoubleDoubleT(const T& h) : hi(h), lo(0) {}
+	DoubleDoubleT(const T& h, const T& l) : hi(h), lo(l) {}
+};
+
+using DoubleDouble = DoubleDoubleT<double>;
+
+namespace DoubleDoubleDetail
+{
+	// a + b = s + e exactly, for any a and b
+	template <typename T>
+	inline DoubleDoubleT<T> TwoSum(const T& a, const T& b)
+	{
+		T s = a + b;
+		T bb = s - a;
+		T e = (a - (s - bb)) + (b - bb);
+		return { s, e };
+	}
+
+	// a + b = s + e exactly, when |a| >= |b|
+	template <typename T>
+	inline DoubleDoubleT<T> QuickTwoSum(const T& a, const T& b)
+	{
+		T s = a + b;
+		T e = b - (s - a);
+		return { s, e };
+	}
+
+	// Dekker's split of a into two halves of 26 bits, a = hi + lo
+	template <typename T>
+	inline void Split(const T& a, T& hi, T& lo)
+	{
+		T t = T(134217729.0) * a;	// 2^27 + 1
+		hi = t - (t - a);
+		lo = a - hi;
+	}
+
+	// a * b = p + e exactly, with a fused multiply-add when the hardware has it, else by Dekker's split
+	template <typename T>
+	inline DoubleDoubleT<T> TwoProd(const T& a, const T& b)
+	{
+		T p = a * b;
+#ifdef FP_FAST_FMA
+		using std::fma;
+		T e = fma(a, b, -p);
+#else
+		T ahi, alo, bhi, blo;
+		Split(a, ahi, alo);
+		Split(b, bhi, blo);
+		T e = ((ahi * bhi - p) + ahi * blo + alo * bhi) + alo * blo;
+#endif
+		return { p, e };
+	}
+}
+
+template <typename T>
+inline DoubleDoubleT<T> operator+(const DoubleDoubleT<T>& a, const DoubleDoubleT<T>& b)
+{
+	using namespace DoubleDoubleDetail;
+	DoubleDoubleT<T> s = TwoSum(a.hi, b.hi);
+	DoubleDoubleT<T> t = TwoSum(a.lo, b.lo);
+	s.lo += t.hi;
+	s = QuickTwoSum(s.hi, s.lo);
+	s.lo += t.lo;
+	return QuickTwoSum(s.hi, s.lo);
+}
+
+template <typename T>
+inline DoubleDoubleT<T> operator+(const DoubleDoubleT<T>& a, const T& b)
+{
+	using namespace DoubleDoubleDetail;
+	DoubleDoubleT<T> s = TwoSum(a.hi, b);
+	s.lo += a.lo;
+	return QuickTwoSum(s.hi, s.lo);
+}
+
+template <typename T>
+inline DoubleDoubleT<T> operator-(const DoubleDoubleT<T>& a)
+{
+	return { -a.hi, -a.lo };
+}
+
+template <typename T>
+inline DoubleDoubleT<T> operator-(const DoubleDoubleT<T>& a, const DoubleDoubleT<T>& b)
+{
+	return a + -b;
+}
+
+template <typename T>
+inline DoubleDoubleT<T> operator-(const DoubleDoubleT<T>& a, const T& b)
+{
+	return a + -b;
+}
+
+template <typename T>
+inline DoubleDoubleT<T> operator*(const DoubleDoubleT<T>& a, const DoubleDoubleT<T>& b)
+{
+	using namespace DoubleDoubleDetail;
+	DoubleDoubleT<T> p = TwoProd(a.hi, b.hi);
+	p.lo += a.hi * b.lo + a.lo * b.hi;
+	return QuickTwoSum(p.hi, p.lo);
+}
+
+template <typename T>
+inline DoubleDoubleT<T> operator*(const DoubleDoubleT<T>& a, const T& b)
+{
+	using namespace DoubleDoubleDetail;
+	DoubleDoubleT<T> p = TwoProd(a.hi, b);
+	p.lo += a.lo * b;
+	return QuickTwoSum(p.hi, p.lo);
+}
+
+template <typename T>
+inline DoubleDoubleT<T>& operator+=(DoubleDoubleT<T>& a, const DoubleDoubleT<T>& b)
+{
+	return a = a + b;
+}
+
+template <typename T>
+inline DoubleDoubleT<T>& operator+=(DoubleDoubleT<T>& a, const T& b)
+{
+	return a = a + b;
+}
+
+// Comparisons give bool for double, and a simd mask for the simd types
+template <typename T>
+inline auto operator<=(const DoubleDoubleT<T>& a, const DoubleDoubleT<T>& b)
+{
+	return (a.hi < b.hi) || ((a.hi == b.hi) && (a.lo <= b.lo));
+}
+
+template <typename T>
+inline auto operator<(const DoubleDoubleT<T>& a, const DoubleDoubleT<T>& b)
+{
+	return (a.hi < b.hi) || ((a.hi == b.hi) && (a.lo < b.lo));
+}
+
+// The sign of a double-double is the sign of hi, which is then applied to both parts
+template <typename T>
+inline DoubleDoubleT<T> abs(const DoubleDoubleT<T>& a)
+{
+	using std::copysign;
+	T sign = copysign(T(1), a.hi);
+	return { a.hi * sign, a.lo * sign };
+}
+
+// Rounded to the underlying type, which is hi, as lo is below half an ulp of it
+template <typename T>
+inline T ToDouble(const DoubleDoubleT<T>& a)
+{
+	return a.hi;
+}
@@ -0,0 +1,223 @@
+/*
+This code is:
+
+Copyright 2024 - 2025 Frank B. Jakobsen
+
+It is released under the same license as PgeMandelbrotParallel.cpp, the OLC 3
+
+128 bit signed fixed point numbers, with nIntegerBits integer bits including the sign,
+and the rest of the bits for the fraction.
+
+All arithmetic is done with integers, so the results are bit identical on every compiler
+and CPU, independent of floating point contraction and rounding modes.
+Multiplication truncates the magnitude of the exact product, and conversion from double
+truncates the bits below the resolution, so both are also well defined everywhere.
+
+g++ and clang store the value in an __int128. MSVC has no 128 bit integer type,
+and uses two 64 bit halves with the same arithmetic.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+#endif
+
+class Fixed128
+{
+public:
+	static constexpr int nIntegerBits = 12;		// Values up to +-2048, enough for the squares of the iterations before escape
+	static constexpr int nFractionBits = 128 - nIntegerBits;
+
+	Fixed128() = default;
+
+	// Truncates toward zero at the resolution of the fraction bits
+	// |d| must be below 2^(nIntegerBits - 1), larger values wrap around like the integer arithmetic
+	explicit Fixed128(double d)
+	{
+		int exponent = 0;
+		double mantissa = std::frexp(std::abs(d), &exponent);	// |d| = mantissa * 2^exponent, mantissa in [0.5, 1)
+		uint64_t bits = (uint64_t)std::ldexp(mantissa, 53);		// Exact, the 53 bits of the mantissa
+		int shift = exponent - 53 + nFractionBits;
+
+		Magnitude m{ bits, 0 };
+		m = shift >= 0 ? ShiftLeft(m, shift) : ShiftRight(m, -shift);
+		*this = FromMagnitude(m, d < 0);
+	}
+
+	friend Fixed128 operator+(const Fixed128& a, const Fixed128& b)
+	{
+		Fixed128 r;
+#if defined(__SIZEOF_INT128__)
+		r.v = (__int128)((unsigned __int128)a.v + (unsigned __int128)b.v);
+#else
+		r.lo = a.lo + b.lo;
+		r.hi = a.hi + b.hi + (r.lo < a.lo ? 1 : 0);
+#endif
+		return r;
+	}
+
+	friend Fixed128 operator-(const Fixed128& a)
+	{
+		Fixed128 r;
+#if defined(__SIZEOF_INT128__)
+		r.v = (__int128)(0 - (unsigned __int128)a.v);
+#else
+		r.lo = 0 - a.lo;
+		r.hi = 0 - a.hi - (a.lo != 0 ? 1 : 0);
+#endif
+		return r;
+	}
+
+	friend Fixed128 operator-(const Fixed128& a, const Fixed128& b)
+	{
+		return a + -b;
+	}
+
+	// The product is calculated from the magnitudes, so it truncates toward zero
+	friend Fixed128 operator*(const Fixed128& a, const Fixed128& b)
+	{
+		return FromMagnitude(MultiplyShifted(a.ToMagnitude(), b.ToMagnitude()), a.IsNegative() != b.IsNegative());
+	}
+
+	friend bool operator<(const Fixed128& a, const Fixed128& b)
+	{
+#if defined(__SIZEOF_INT128__)
+		return a.v < b.v;
+#else
+		return (int64_t)a.hi < (int64_t)b.hi || (a.hi == b.hi && a.lo < b.lo);
+#endif
+	}
+
+	friend bool operator<=(const Fixed128& a, const Fixed128& b)
+	{
+		return !(b < a);
+	}
+
+	friend Fixed128 abs(const Fixed128& a)
+	{
+		return a.IsNegative() ? -a : a;
+	}
+
+private:
+#if defined(__SIZEOF_INT128__)
+	__int128 v = 0;
+#else
+	uint64_t lo = 0;
+	uint64_t hi = 0;	// Two's complement of the complete 128 bits
+#endif
+
+	// Unsigned 128 bit value as two 64 bit halves, used by conversion and multiplication
+	struct Magnitude
+	{
+		uint64_t lo;
+		uint64_t hi;
+	};
+
+	bool IsNegative() const
+	{
+#if defined(__SIZEOF_INT128__)
+		return v < 0;
+#else
+		return (int64_t)hi < 0;
+#endif
+	}
+
+	Magnitude ToMagnitude() const
+	{
+		Fixed128 a = IsNegative() ? -*this : *this;
+#if defined(__SIZEOF_INT128__)
+		return { (uint64_t)a.v, (uint64_t)((unsigned __int128)a.v >> 64) };
+#else
+		return { a.lo, a.hi };
+#endif
+	}
+
+	static Fixed128 FromMagnitude(const Magnitude& m, bool bNegative)
+	{
+		Fixed128 r;
+#if defined(__SIZEOF_INT128__)
+		r.v = (__int128)(((unsigned __int128)m.hi << 64) | m.lo);
+#else
+		r.lo = m.lo;
+		r.hi = m.hi;
+#endif
+		return bNegative ? -r : r;
+	}
+
+	static Magnitude ShiftLeft(const Magnitude& m, int shift)
+	{
+		if (shift >= 128)
+			return { 0, 0 };
+		if (shift >= 64)
+			return { 0, m.lo << (shift - 64) };
+		if (shift == 0)
+			return m;
+		return { m.lo << shift, (m.hi << shift) | (m.lo >> (64 - shift)) };
+	}
+
+	static Magnitude ShiftRight(const Magnitude& m, int shift)
+	{
+		if (shift >= 128)
+			return { 0, 0 };
+		if (shift >= 64)
+			return { m.hi >> (shift - 64), 0 };
+		if (shift == 0)
+			return m;
+		return { (m.lo >> shift) | (m.hi << (64 - shift)), m.hi >> shift };
+	}
+
+	// The full 128 bit product of two 64 bit values, the high half returned in hi
+	static uint64_t Multiply64(uint64_t a, uint64_t b, uint64_t& hi)
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 p = (unsigned __int128)a * b;
+		hi = (uint64_t)(p >> 64);
+		return (uint64_t)p;
+#elif defined(_MSC_VER) && defined(_M_X64)
+		return _umul128(a, b, &hi);
+#else
+		uint64_t a0 = (uint32_t)a, a1 = a >> 32;
+		uint64_t b0 = (uint32_t)b, b1 = b >> 32;
+		uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+		uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+		hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+		return (mid << 32) | (uint32_t)p00;
+#endif
+	}
+
+	// Adds b to the 128 bit value (lo, hi)
+	static void Accumulate(uint64_t& lo, uint64_t& hi, uint64_t b)
+	{
+		lo += b;
+		hi += lo < b ? 1 : 0;
+	}
+
+	// The 256 bit product a * b shifted right by nFractionBits, keeping the lower 128 bits
+	static Magnitude MultiplyShifted(const Magnitude& a, const Magnitude& b)
+	{
+		uint64_t h00, h01, h10, h11;
+		uint64_t l00 = Multiply64(a.lo, b.lo, h00);
+		uint64_t l01 = Multiply64(a.lo, b.hi, h01);
+		uint64_t l10 = Multiply64(a.hi, b.lo, h10);
+		uint64_t l11 = Multiply64(a.hi, b.hi, h11);
+
+		// Product words r0 to r3, from the least significant
+		uint64_t r1 = h00, carry1 = 0;
+		Accumulate(r1, carry1, l01);
+		Accumulate(r1, carry1, l10);
+
+		uint64_t r2 = l11, r3 = h11;
+		Accumulate(r2, r3, h01);
+		Accumulate(r2, r3, h10);
+		Accumulate(r2, r3, carry1);
+
+		// Bits nFractionBits to nFractionBits + 127 of the product
+		Magnitude low = ShiftRight({ l00, r1 }, nFractionBits);
+		Magnitude high = ShiftLeft({ r2, r3 }, 128 - nFractionBits);
+		return { low.lo | high.lo, low.hi | high.hi };
+	}
+};
@@ -0,0 +1,143 @@
+/*
+This code is:
+
+Copyright 2024 - 2025 Frank B. Jakobsen
+
+It is released under the same license as PgeMandelbrotParallel.cpp, the OLC 3
+
+A file mapped into memory, with the same interface for Windows and POSIX systems.
+An existing file is mapped read only, and a new file is created with a given size and mapped for writing.
+The mapping is released, and the contents written, when the object is destroyed.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#if defined(_WIN32)
+	#if !defined(NOMINMAX)
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+class MappedFile
+{
+public:
+	// Map an existing file for reading
+	explicit MappedFile(const std::string& path)
+	{
+		Open(path, 0, false);
+	}
+
+	// Create the file, or truncate an existing one, with the given size, and map it for writing
+	MappedFile(const std::string& path, size_t size)
+	{
+		Open(path, size, true);
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile()
+	{
+		Close();
+	}
+
+	bool IsOpen() const { return pData != nullptr; }
+
+	void* Data() const { return pData; }
+
+	size_t Size() const { return nSize; }
+
+private:
+	void* pData = nullptr;
+	size_t nSize = 0;
+
+#if defined(_WIN32)
+	HANDLE hFile = INVALID_HANDLE_VALUE;
+	HANDLE hMapping = nullptr;
+
+	void Open(const std::string& path, size_t size, bool bWrite)
+	{
+		hFile = CreateFileA(path.c_str(), bWrite ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+			bWrite ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (hFile == INVALID_HANDLE_VALUE)
+			return;
+
+		if (!bWrite)
+		{
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(hFile, &fileSize))
+				return;
+			size = (size_t)fileSize.QuadPart;
+		}
+		if (size == 0)
+			return;
+
+		hMapping = CreateFileMappingA(hFile, nullptr, bWrite ? PAGE_READWRITE : PAGE_READONLY,
+			(DWORD)((unsigned long long)size >> 32), (DWORD)size, nullptr);
+		if (hMapping == nullptr)
+			return;
+
+		pData = MapViewOfFile(hMapping, bWrite ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+		if (pData != nullptr)
+			nSize = size;
+	}
+
+	void Close()
+	{
+		if (pData != nullptr)
+			UnmapViewOfFile(pData);
+		if (hMapping != nullptr)
+			CloseHandle(hMapping);
+		if (hFile != INVALID_HANDLE_VALUE)
+			CloseHandle(hFile);
+	}
+#else
+	int fd = -1;
+
+	void Open(const std::string& path, size_t size, bool bWrite)
+	{
+		fd = bWrite ? open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return;
+
+		if (bWrite)
+		{
+			if (ftruncate(fd, (off_t)size) != 0)
+				return;
+		}
+		else
+		{
+			struct stat status;
+			if (fstat(fd, &status) != 0)
+				return;
+			size = (size_t)status.st_size;
+		}
+		if (size == 0)
+			return;
+
+		void* p = mmap(nullptr, size, bWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+		if (p == MAP_FAILED)
+			return;
+
+		pData = p;
+		nSize = size;
+	}
+
+	void Close()
+	{
+		if (pData != nullptr)
+			munmap(pData, nSize);
+		if (fd >= 0)
+			close(fd);
+	}
+#endif
+};
@@ -19,8 +19,11 @@ Have fun! That's the main purpose for my activities on Excursions With C++ as we
 #define OLC_PGE_APPLICATION
 #include "olcPixelGameEngine.h"
 
-#define OLC_PGEX_TRANSFORMEDVIEW
-#include "olcPGEX_TransformedView.h"
+#include "DoubleDouble.h"
+#include "TransformedViewT.h"
+#include "Fixed128.h"
+#include "BigFixed.h"
+#include "MappedFile.h"
 
 // When the following symbol is defined, the code will also include the usage of TBB when compiling with MSVC
 // TBB must be installed on the PC, and the relevant paths must be set up for include files and libraries
@@ -29,6 +32,10 @@ Have fun! That's the main purpose for my activities on Excursions With C++ as we
 
 #include <algorithm>
 #include <execution>
+#include <limits>
+#include <atomic>
+#include <complex>
+#include <cstring>
 
 #if defined(_MSC_VER)
 	#include <ppl.h>
@@ -43,6 +50,40 @@ Have fun! That's the main purpose for my activities on Excursions With C++ as we
 #include "tbb/tbb.h"
 #endif
 
+// The portable SIMD kernel uses std::experimental::simd when the standard library has it (libstdc++ from g++ 11)
+// Otherwise the portable kernel is the scalar MandelbrotCount
+#if __has_include(<experimental/simd>)
+	#include <experimental/simd>
+	#if defined(__cpp_lib_experimental_parallel_simd)
+		#define USE_STD_SIMD 1
+	#endif
+#endif
+
+// SIMD intrinsics are only used when compiling for 64 bit x86
+#if defined(__x86_64__) || defined(_M_X64)
+	#define USE_X86_SIMD 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+	#endif
+#endif
+
+// g++ and clang only allow intrinsics for instruction sets enabled for the function being compiled
+// The build scripts do not use -march, so the AVX2 and AVX-512 functions are marked individually,
+// and the best one is selected at runtime. MSVC allows all intrinsics without any marking
+// AVX-512 includes FMA, and g++ would then contract the multiplies and adds of the intrinsics,
+// giving counts different from the scalar kernel
+#if defined(__clang__)
+	#define TARGET_AVX2 __attribute__((target("avx2")))
+	#define TARGET_AVX512 __attribute__((target("avx512f")))
+#elif defined(__GNUC__)
+	#define TARGET_AVX2 __attribute__((target("avx2")))
+	#define TARGET_AVX512 __attribute__((target("avx512f"), optimize("fp-contract=off")))
+#else
+	#define TARGET_AVX2
+	#define TARGET_AVX512
+#endif
+
 class PgeMandelbrotParallel : public olc::PixelGameEngine
 {
 public:
@@ -54,7 +95,10 @@ public:
 private:
 	// This extension will know the current PGE object
 	// through a public static variable in PGEX
-	olc::TransformedView tv;
+	// The world coordinates are double-double, for zooms far beyond the float of olc::TransformedView
+	// They end near a pixel spacing of 1e-30, where double-double can no longer tell the pixels apart,
+	// and so does every draw mode, including perturbation with its BigFixed reference orbit
+	TransformedViewT<DoubleDouble> tv;
 
 	void ResetView()
 	{
@@ -63,276 +107,3238 @@ private:
 		// contains the complete Mandelbrot set
 		// Goes from upper left (-2, 1.5) to lower right (1.0, -1.5) in Mandelbrot world
 		// Get the smallest scale to fit it all
-		float scale =
-			std::min<float>(ScreenWidth() / (3.0), ScreenHeight() / (3.0));
+		double scale =
+			std::min<double>(ScreenWidth() / (3.0), ScreenHeight() / (3.0));
 		// World y and screen y goes in opposite directions, therefore the negative scale for y
 		tv.Initialise(
 			{ ScreenWidth(), ScreenHeight() },
 			{ scale, -scale });
-		// Recalculate world offset
-		tv.SetWorldOffset({ 0,0 });
-		tv.SetWorldOffset(-(tv.ScreenToWorld(olc::vf2d{ (float) ScreenWidth() / 2, (float) ScreenHeight() / 2 })));
+		// Recalculate world offset, so the world origin is at the center of the screen
+		olc::vd2d center = olc::vd2d{ (double) ScreenWidth() / 2, (double) ScreenHeight() / 2 } / tv.GetWorldScale();
+		tv.SetWorldOffset({ -center.x, -center.y });
 	}
 
 	// Define a type for a drawing function
 	using DrawFunction = void ();
 
-	// Define a struct for information about a draw function
-	struct DrawFunctionDescription
+	// Define a struct for information about a draw function
+	struct DrawFunctionDescription
+	{
+		olc::Key commandKey;		// Key to select this calculation method
+		std::string commandKeyName;	// Name of Key for display
+		std::string description;	// Description of this draw function
+		DrawFunction PgeMandelbrotParallel::* pDrawFunction;
+									// Pointer to the draw function as a member method
+		DrawFunction PgeMandelbrotParallel::* pFormulaFallback = nullptr;
+									// The draw function for other formulas than Mandelbrot, if the mode only has Mandelbrot
+	};
+
+	// Vector of information for the draw functions to be investigated
+	// Initialized at the bottom of this file
+	static std::vector<DrawFunctionDescription> DrawFunctions;
+
+	// Index of the currently selected draw function
+	size_t nCurrentDrawFunctionIndex = 0;
+
+	// The draw function of the current draw mode for the current formula
+	// Perturbation and the modes built on it iterate the difference d = 2Zd + d^2 + dc, which only holds for
+	// the Mandelbrot formula, so for the other formulas they draw with the SIMD kernel given as their fallback
+	DrawFunction PgeMandelbrotParallel::* CurrentDrawFunction()
+	{
+		const DrawFunctionDescription& drawFunction = DrawFunctions[nCurrentDrawFunctionIndex];
+		if (drawFunction.pFormulaFallback && !Formulas[nCurrentFormulaIndex].bMandelbrot)
+			return drawFunction.pFormulaFallback;
+		return drawFunction.pDrawFunction;
+	}
+
+	// The Mandelbrot algorithm
+	int32_t maxCount;  // Max count for the iterative function
+	const float pi = std::acos(-1.0F);
+	const float pithird = pi / 3;
+
+
+	// Closed form test for the two largest components of the Mandelbrot set,
+	// the main cardioid and the period-2 bulb, whose points never escape
+	// Written with | instead of ||, so it also works for the masks of the std::simd types
+	template <typename T>
+	static auto InMainCardioidOrPeriod2Bulb(const T& x, const T& y)
+	{
+		T xq = x - T(0.25f);
+		T y2 = y * y;
+		T q = xq * xq + y2;
+		T xb = x + T(1.0f);
+		return (q * (q + xq) <= T(0.25f) * y2) | (xb * xb + y2 <= T(0.0625f));
+	}
+
+	// Periodicity checking, Brent's cycle detection
+	// The first orbit point is saved after nPeriodicityCheckInterval iterations, and is then replaced
+	// after intervals that double each time, so a cycle of any length is eventually found.
+	// From the first save the orbit is compared with the saved point in each iteration. An orbit returning
+	// within the epsilon of the saved point has fallen into an attracting cycle, and the point is inside the set.
+	// Most exterior points escape before the first save, so a longer interval costs them less,
+	// but finds the cycles of interior points later. An interval of 0 turns the check off
+	int nPeriodicityCheckInterval = 64;
+	// For float the epsilon is only a few ulps of an orbit near |z| = 2, as 256 eps took exterior points passing
+	// close to their saved point for interior, e.g. 58 pixels of the antenna at a pixel spacing of 1e-4.
+	// With 16 eps at most 2 pixels in the views tried differ from no check, and 84% to 96% of the skipped iterations remain
+	template <typename T>
+	static constexpr T PeriodicityEpsilon() { return (std::is_same_v<T, float> ? 16 : 256) * std::numeric_limits<T>::epsilon(); }
+
+	// Iterations saved by the periodicity check in the current frame
+	std::atomic<int64_t> nPeriodicitySavedIterations{ 0 };
+
+	// The iteration formulas, as policies for the kernel templates
+	// Each formula gets its own instance of the kernels, with the step inlined in the loop
+	// Step calculates z = f(z) + c from z and its squares, using only operators and abs,
+	// so it works for double, float and the std::simd types alike
+	struct MandelbrotFormula
+	{
+		static constexpr bool bMainCardioidTest = true;	// The closed form interior test applies
+
+		template <typename T>
+		static void Step(T& zx, T& zy, const T& zx2, const T& zy2, const T& cx, const T& cy)
+		{
+			zy = (zy + zy) * zx + cy;
+			zx = zx2 - zy2 + cx;
+		}
+	};
+
+	// The Mandelbrot formula with the complex conjugate, z = conj(z)^2 + c
+	struct TricornFormula
+	{
+		static constexpr bool bMainCardioidTest = false;
+
+		template <typename T>
+		static void Step(T& zx, T& zy, const T& zx2, const T& zy2, const T& cx, const T& cy)
+		{
+			zy = cy - (zy + zy) * zx;
+			zx = zx2 - zy2 + cx;
+		}
+	};
+
+	// The Mandelbrot formula with the absolute values of the components, z = (|x| + i|y|)^2 + c
+	struct BurningShipFormula
+	{
+		static constexpr bool bMainCardioidTest = false;
+
+		template <typename T>
+		static void Step(T& zx, T& zy, const T& zx2, const T& zy2, const T& cx, const T& cy)
+		{
+			using std::abs;		// abs of the std::simd types is found by argument dependent lookup
+			zy = abs((zy + zy) * zx) + cy;
+			zx = zx2 - zy2 + cx;
+		}
+	};
+
+	// Multibrot, z = z^Power + c, with the power multiplied out at compile time
+	template <int Power>
+	struct MultibrotFormula
+	{
+		static_assert(Power >= 2, "Multibrot power must be at least 2");
+		static constexpr bool bMainCardioidTest = Power == 2;
+
+		template <typename T>
+		static void Step(T& zx, T& zy, const T& zx2, const T& zy2, const T& cx, const T& cy)
+		{
+			// z^2 from the squares already calculated, then the remaining factors of z
+			T px = zx2 - zy2;
+			T py = (zy + zy) * zx;
+			for (int i = 2; i < Power; i++)
+			{
+				T t = px * zx - py * zy;
+				py = px * zy + py * zx;
+				px = t;
+			}
+			zx = px + cx;
+			zy = py + cy;
+		}
+	};
+
+	template <typename Formula = MandelbrotFormula>
+	int MandelbrotCount(double x, double y, int64_t& nSavedIterations)
+	{
+		if constexpr (Formula::bMainCardioidTest)
+		{
+			if (InMainCardioidOrPeriod2Bulb(x, y))
+				return maxCount;
+		}
+
+		double zx = x;
+		double zy = y;
+		double zx2 = zx * zx;
+		double zy2 = zy * zy;
+
+		double zxSaved = 0;
+		double zySaved = 0;
+		int saveInterval = nPeriodicityCheckInterval;
+		int nextSave = saveInterval;
+
+		int count = 0;
+
+		while (count < maxCount && zx2 + zy2 <= 4.0)
+		{
+			Formula::Step(zx, zy, zx2, zy2, x, y);
+			zx2 = zx * zx;
+			zy2 = zy * zy;
+
+			count++;
+
+			if (saveInterval > 0)
+			{
+				if (count > nPeriodicityCheckInterval &&
+					std::abs(zx - zxSaved) + std::abs(zy - zySaved) <= PeriodicityEpsilon<double>())
+				{
+					nSavedIterations += maxCount - count;
+					return maxCount;
+				}
+
+				if (count == nextSave)
+				{
+					zxSaved = zx;
+					zySaved = zy;
+					saveInterval *= 2;
+					nextSave += saveInterval;
+				}
+			}
+		}
+
+		return count;
+	}
+
+	// Palette based on @Eriksonn's calculation, see my post and OneLoneCoder Discord channel
+	olc::Pixel CountToPixel(int count)
+	{
+		if (count >= maxCount)
+			return olc::BLACK;
+
+		float angle = 2 * pi * count / maxCount;
+		return olc::PixelF(0.5f * sin(angle) + 0.5f, 0.5f * sin(angle + 2 * pithird) + 0.5f, 0.5f * sin(angle + 4 * pithird) + 0.5f);
+	}
+
+	// Signature of a row kernel, calculating the counts for nPixels pixels at the x coordinates pWorldX of the row worldY
+	// The coordinates are given by the caller, so every kernel and every draw mode calculates exactly the same points
+	using MandelbrotRowFunction = void (const double* pWorldX, double worldY, int nPixels, int* pCounts);
+
+	// The row kernels for the best instruction set supported by this CPU, selected at startup
+	MandelbrotRowFunction PgeMandelbrotParallel::* pMandelbrotRow = &PgeMandelbrotParallel::MandelbrotRowScalar;
+	MandelbrotRowFunction PgeMandelbrotParallel::* pMandelbrotRowFloat = &PgeMandelbrotParallel::MandelbrotRowScalar;
+	std::string sKernelISA = "Scalar";
+
+	// At shallow zoom float gives the same image as double, with twice the lanes per register
+	// The float kernels are used while the pixel spacing is at least this many times the float
+	// resolution of the coordinates in the view
+	static constexpr double fFloatPrecisionMargin = 256.0;
+	bool bAutoFloat = true;			// Toggled with the P key
+	bool bFloatPrecision = false;	// Decided for each frame
+
+	// Past the resolution of double, all draw modes use the double-double kernels
+	// They are used while the pixel spacing is below this many times the double resolution of the coordinates
+	static constexpr double fDoublePrecisionMargin = 64.0;
+	bool bDoubleDoublePrecision = false;	// Decided for each frame
+
+	// Is the pixel spacing at least margin times the resolution of T for the coordinates in the view
+	template <typename T>
+	bool PrecisionSufficient(double margin)
+	{
+		olc::vd2d worldScale = tv.GetWorldScale();
+		olc::vd2d worldTL = tv.GetWorldTL();
+		olc::vd2d worldBR = tv.GetWorldBR();
+
+		double pixelSpacing = std::min(std::abs(1.0 / worldScale.x), std::abs(1.0 / worldScale.y));
+		double maxCoordinate = std::max({ std::abs(worldTL.x), std::abs(worldTL.y), std::abs(worldBR.x), std::abs(worldBR.y), 1.0 });
+
+		return pixelSpacing >= margin * std::numeric_limits<T>::epsilon() * maxCoordinate;
+	}
+
+	bool FloatPrecisionSufficient()
+	{
+		return PrecisionSufficient<float>(fFloatPrecisionMargin);
+	}
+
+	bool DoublePrecisionSufficient()
+	{
+		return PrecisionSufficient<double>(fDoublePrecisionMargin);
+	}
+
+	template <typename Formula = MandelbrotFormula>
+	void MandelbrotRowScalar(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		int64_t nSavedIterations = 0;
+		for (int x = 0; x < nPixels; x++)
+			pCounts[x] = MandelbrotCount<Formula>(pWorldX[x], worldY, nSavedIterations);
+		nPeriodicitySavedIterations += nSavedIterations;
+	}
+
+	// Scalar row kernel iterating N independent pixels interleaved in the same loop
+	// The single pixel loop is one long dependency chain, where each step waits for the latency
+	// of the previous multiply. Here the steps of the N pixels can execute at the same time.
+	// A pixel is retired as soon as it escapes, and its slot is refilled with the next pixel of the row
+	template <typename Formula, int N>
+	void MandelbrotRowInterleaved(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		const double cy = worldY;
+
+		// The state of the pixel in each slot, index -1 is an empty slot
+		int index[N];
+		double cx[N], zx[N], zy[N], zx2[N], zy2[N];
+		int count[N];
+
+		int nextPixel = 0;
+		int nActive = 0;
+
+		// Fill a slot with the next pixel needing iterations
+		auto refill = [&](int slot)
+		{
+			index[slot] = -1;
+			while (nextPixel < nPixels)
+			{
+				int pixel = nextPixel++;
+				double x = pWorldX[pixel];
+
+				if constexpr (Formula::bMainCardioidTest)
+				{
+					if (InMainCardioidOrPeriod2Bulb(x, cy))
+					{
+						pCounts[pixel] = maxCount;
+						continue;
+					}
+				}
+
+				index[slot] = pixel;
+				cx[slot] = x;
+				zx[slot] = x;
+				zy[slot] = cy;
+				zx2[slot] = x * x;
+				zy2[slot] = cy * cy;
+				count[slot] = 0;
+				nActive++;
+				break;
+			}
+		};
+
+		for (int slot = 0; slot < N; slot++)
+			refill(slot);
+
+		while (nActive > 0)
+		{
+			for (int slot = 0; slot < N; slot++)
+			{
+				// A refilled pixel may also escape right away
+				while (index[slot] >= 0 && (count[slot] >= maxCount || zx2[slot] + zy2[slot] > 4.0))
+				{
+					pCounts[index[slot]] = count[slot];
+					nActive--;
+					refill(slot);
+				}
+
+				if (index[slot] < 0)
+					continue;
+
+				Formula::Step(zx[slot], zy[slot], zx2[slot], zy2[slot], cx[slot], cy);
+				zx2[slot] = zx[slot] * zx[slot];
+				zy2[slot] = zy[slot] * zy[slot];
+				count[slot]++;
+			}
+		}
+	}
+
+#if defined(USE_STD_SIMD)
+	// Row kernel written against std::experimental::simd, calculating N pixels of type T at a time
+	// The compiler maps it to the vector registers of the target, e.g. SSE2 on x86-64 and NEON on ARM64
+	template <typename Formula, typename T, int N>
+	void MandelbrotRowStdSimd(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		namespace stdx = std::experimental;
+		using Real = stdx::fixed_size_simd<T, N>;
+		using Count = stdx::fixed_size_simd<int, N>;
+
+		const Real four = 4;
+		const Real cy = (T)worldY;
+		const Real epsilon = PeriodicityEpsilon<T>();
+
+		// Summed in int64_t, as a float sum loses whole iterations past 2^24
+		int64_t nSavedIterations = 0;
+
+		// The last block repeats the last pixel in its unused lanes, so every pixel is calculated in T
+		for (int x = 0; x < nPixels; x += N)
+		{
+			T xs[N];
+			for (int lane = 0; lane < N; lane++)
+				xs[lane] = (T)pWorldX[std::min(x + lane, nPixels - 1)];
+
+			const Real cx(xs, stdx::element_aligned);
+			Real zx = cx;
+			// Lanes inside the main cardioid or the period-2 bulb start as NaN, so they are never active
+			typename Real::mask_type interior(false);
+			if constexpr (Formula::bMainCardioidTest)
+				interior = InMainCardioidOrPeriod2Bulb(cx, cy);
+			stdx::where(interior, zx) = std::numeric_limits<T>::quiet_NaN();
+			Real zy = cy;
+			Real zx2 = zx * zx;
+			Real zy2 = zy * zy;
+			// Counted in T, so the mask of the escape test can be used directly
+			Real counts = 0;
+
+			// All lanes share the schedule for saving the orbit point
+			Real zxSaved = 0;
+			Real zySaved = 0;
+			int saveInterval = nPeriodicityCheckInterval;
+			int nextSave = saveInterval;
+			typename Real::mask_type periodic(false);
+
+			for (int count = 0; count < maxCount; count++)
+			{
+				auto active = zx2 + zy2 <= four;
+				if (stdx::none_of(active))
+					break;
+
+				stdx::where(active, counts) += 1;
+
+				Formula::Step(zx, zy, zx2, zy2, cx, cy);
+				zx2 = zx * zx;
+				zy2 = zy * zy;
+
+				if (saveInterval > 0)
+				{
+					if (count >= nPeriodicityCheckInterval)
+					{
+						// Lanes in a cycle get zx2 as NaN, so they are not active any more
+						auto cycle = active && (stdx::abs(zx - zxSaved) + stdx::abs(zy - zySaved) <= epsilon);
+						periodic = periodic || cycle;
+						stdx::where(cycle, zx2) = std::numeric_limits<T>::quiet_NaN();
+					}
+
+					if (count + 1 == nextSave)
+					{
+						zxSaved = zx;
+						zySaved = zy;
+						saveInterval *= 2;
+						nextSave += saveInterval;
+					}
+				}
+			}
+
+			Real saved = 0;
+			stdx::where(periodic, saved) = (T)maxCount - counts;
+			nSavedIterations += stdx::reduce(stdx::static_simd_cast<Count>(saved));
+
+			stdx::where(interior || periodic, counts) = (T)maxCount;
+			if (x + N <= nPixels)
+				stdx::static_simd_cast<Count>(counts).copy_to(pCounts + x, stdx::element_aligned);
+			else
+			{
+				int laneCounts[N];
+				stdx::static_simd_cast<Count>(counts).copy_to(laneCounts, stdx::element_aligned);
+				std::copy(laneCounts, laneCounts + (nPixels - x), pCounts + x);
+			}
+		}
+
+		nPeriodicitySavedIterations += nSavedIterations;
+	}
+
+	// Two native registers per step gives two independent dependency chains
+	static constexpr int nPortableLanes = 2 * (int)std::experimental::native_simd<double>::size();
+
+	// Row kernel iterating in blocks of BlockSize iterations, with the escape test only once per block
+	// Inside a block there is no compare and branch, and the steps can be fully unrolled.
+	// When lanes have escaped during a block, the block is rolled back to its start and repeated with
+	// a test in each step, to find the exact escape iteration. There is no periodicity check, so the counts are
+	// those of MandelbrotCount with nPeriodicityCheckInterval 0
+	template <typename Formula, typename T, int N, int BlockSize>
+	void MandelbrotRowBlocked(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		namespace stdx = std::experimental;
+		using Real = stdx::fixed_size_simd<T, N>;
+		using Count = stdx::fixed_size_simd<int, N>;
+
+		const Real four = 4;
+		const Real cy = (T)worldY;
+
+		// The last block repeats the last pixel in its unused lanes, so every pixel is calculated in T
+		for (int x = 0; x < nPixels; x += N)
+		{
+			T xs[N];
+			for (int lane = 0; lane < N; lane++)
+				xs[lane] = (T)pWorldX[std::min(x + lane, nPixels - 1)];
+
+			const Real cx(xs, stdx::element_aligned);
+			Real zx = cx;
+			Real zy = cy;
+			Real zx2 = zx * zx;
+			Real zy2 = zy * zy;
+			Real counts = 0;
+
+			// Lanes that have escaped, or are inside the main cardioid or period-2 bulb, are done
+			typename Real::mask_type interior(false);
+			if constexpr (Formula::bMainCardioidTest)
+				interior = InMainCardioidOrPeriod2Bulb(cx, cy);
+			auto done = interior || !(zx2 + zy2 <= four);
+
+			int count = 0;
+			while (count < maxCount && !stdx::all_of(done))
+			{
+				Real zxStart = zx;
+				Real zyStart = zy;
+				Real zx2Start = zx2;
+				Real zy2Start = zy2;
+
+				int steps = std::min(BlockSize, maxCount - count);
+				if (steps == BlockSize)
+				{
+					for (int step = 0; step < BlockSize; step++)
+					{
+						Formula::Step(zx, zy, zx2, zy2, cx, cy);
+						zx2 = zx * zx;
+						zy2 = zy * zy;
+					}
+
+					// Written as not inside, as the lanes that escaped early in the block may have overflowed to NaN
+					auto escaped = !(zx2 + zy2 <= four) && !done;
+					if (stdx::none_of(escaped))
+					{
+						stdx::where(!done, counts) += (T)BlockSize;
+						count += BlockSize;
+						continue;
+					}
+
+					zx = zxStart;
+					zy = zyStart;
+					zx2 = zx2Start;
+					zy2 = zy2Start;
+				}
+
+				// The rollback, or the last partial block, one step at a time
+				for (int step = 0; step < steps; step++)
+				{
+					auto active = zx2 + zy2 <= four && !done;
+					stdx::where(active, counts) += 1;
+
+					Formula::Step(zx, zy, zx2, zy2, cx, cy);
+					zx2 = zx * zx;
+					zy2 = zy * zy;
+
+					done = done || !active;
+				}
+				count += steps;
+			}
+
+			stdx::where(interior, counts) = (T)maxCount;
+			if (x + N <= nPixels)
+				stdx::static_simd_cast<Count>(counts).copy_to(pCounts + x, stdx::element_aligned);
+			else
+			{
+				int laneCounts[N];
+				stdx::static_simd_cast<Count>(counts).copy_to(laneCounts, stdx::element_aligned);
+				std::copy(laneCounts, laneCounts + (nPixels - x), pCounts + x);
+			}
+		}
+	}
+#endif
+
+	// The double-double kernels, for pixel spacings below the resolution of double
+	// The coordinates are given in double-double, as a double can not hold the position of a deep pixel.
+	// There is no periodicity check, as its epsilon would have to follow the pixel spacing
+	using MandelbrotRowDoubleDoubleFunction = void (const DoubleDouble* pWorldX, const DoubleDouble& worldY, int nPixels, int* pCounts);
+
+	template <typename Formula>
+	int MandelbrotCountDoubleDouble(const DoubleDouble& x, const DoubleDouble& y)
+	{
+		if constexpr (Formula::bMainCardioidTest)
+		{
+			if (InMainCardioidOrPeriod2Bulb(x, y))
+				return maxCount;
+		}
+
+		DoubleDouble zx = x;
+		DoubleDouble zy = y;
+		DoubleDouble zx2 = zx * zx;
+		DoubleDouble zy2 = zy * zy;
+
+		int count = 0;
+
+		// The escape test does not need more than double
+		while (count < maxCount && zx2.hi + zy2.hi <= 4.0)
+		{
+			Formula::Step(zx, zy, zx2, zy2, x, y);
+			zx2 = zx * zx;
+			zy2 = zy * zy;
+
+			count++;
+		}
+
+		return count;
+	}
+
+	template <typename Formula>
+	void MandelbrotRowDoubleDoubleScalar(const DoubleDouble* pWorldX, const DoubleDouble& worldY, int nPixels, int* pCounts)
+	{
+		for (int i = 0; i < nPixels; i++)
+			pCounts[i] = MandelbrotCountDoubleDouble<Formula>(pWorldX[i], worldY);
+	}
+
+#if defined(USE_STD_SIMD)
+	// The double-double kernel on N lanes, the hi and lo parts each in a simd of doubles
+	template <typename Formula, int N>
+	void MandelbrotRowDoubleDoubleStdSimd(const DoubleDouble* pWorldX, const DoubleDouble& worldY, int nPixels, int* pCounts)
+	{
+		namespace stdx = std::experimental;
+		using Lanes = stdx::fixed_size_simd<double, N>;
+		using Real = DoubleDoubleT<Lanes>;
+		using Count = stdx::fixed_size_simd<int, N>;
+
+		const Lanes four = 4;
+		const Real cy(Lanes(worldY.hi), Lanes(worldY.lo));
+
+		int i = 0;
+		for (; i + N <= nPixels; i += N)
+		{
+			double xsHi[N], xsLo[N];
+			for (int lane = 0; lane < N; lane++)
+			{
+				xsHi[lane] = pWorldX[i + lane].hi;
+				xsLo[lane] = pWorldX[i + lane].lo;
+			}
+
+			const Real cx(Lanes(xsHi, stdx::element_aligned), Lanes(xsLo, stdx::element_aligned));
+			Real zx = cx;
+			typename Lanes::mask_type interior(false);
+			if constexpr (Formula::bMainCardioidTest)
+				interior = InMainCardioidOrPeriod2Bulb(cx, cy);
+			stdx::where(interior, zx.hi) = std::numeric_limits<double>::quiet_NaN();
+			Real zy = cy;
+			Real zx2 = zx * zx;
+			Real zy2 = zy * zy;
+			Lanes counts = 0;
+
+			for (int count = 0; count < maxCount; count++)
+			{
+				auto active = zx2.hi + zy2.hi <= four;
+				if (stdx::none_of(active))
+					break;
+
+				stdx::where(active, counts) += 1;
+
+				Formula::Step(zx, zy, zx2, zy2, cx, cy);
+				zx2 = zx * zx;
+				zy2 = zy * zy;
+			}
+
+			stdx::where(interior, counts) = (double)maxCount;
+			stdx::static_simd_cast<Count>(counts).copy_to(pCounts + i, stdx::element_aligned);
+		}
+
+		MandelbrotRowDoubleDoubleScalar<Formula>(pWorldX + i, worldY, nPixels - i, pCounts + i);
+	}
+#endif
+
+	template <typename Formula>
+	void MandelbrotRowDoubleDouble(const DoubleDouble* pWorldX, const DoubleDouble& worldY, int nPixels, int* pCounts)
+	{
+#if defined(USE_STD_SIMD)
+		MandelbrotRowDoubleDoubleStdSimd<Formula, nPortableLanes>(pWorldX, worldY, nPixels, pCounts);
+#else
+		MandelbrotRowDoubleDoubleScalar<Formula>(pWorldX, worldY, nPixels, pCounts);
+#endif
+	}
+
+	// The 128 bit fixed point kernel, for renders that must be bit identical with every compiler
+	// The iteration only uses integer operations, so no rounding is left to the compiler
+	template <typename Formula>
+	int MandelbrotCountFixed128(const Fixed128& x, const Fixed128& y)
+	{
+		// z starts at c, so c outside the square around the circle with radius 2 escapes at once
+		const Fixed128 two(2.0);
+		if (two < abs(x) || two < abs(y))
+			return 0;
+
+		if constexpr (Formula::bMainCardioidTest)
+		{
+			if (InMainCardioidOrPeriod2Bulb(x, y))
+				return maxCount;
+		}
+
+		const Fixed128 four(4.0);
+
+		Fixed128 zx = x;
+		Fixed128 zy = y;
+		Fixed128 zx2 = zx * zx;
+		Fixed128 zy2 = zy * zy;
+
+		int count = 0;
+
+		while (count < maxCount && zx2 + zy2 <= four)
+		{
+			Formula::Step(zx, zy, zx2, zy2, x, y);
+			zx2 = zx * zx;
+			zy2 = zy * zy;
+
+			count++;
+		}
+
+		return count;
+	}
+
+	// Each coordinate in double-double is converted by its parts, truncated at the resolution of the fraction bits
+	// Coordinates outside the square escape at once, and are tested before the conversion,
+	// as Fixed128 wraps around for values past the integer bits, e.g. when zoomed far out
+	template <typename Formula>
+	void MandelbrotRowFixed128(const DoubleDouble* pWorldX, const DoubleDouble& worldY, int nPixels, int* pCounts)
+	{
+		if (!(std::abs(worldY.hi) <= 2.0))
+		{
+			std::fill(pCounts, pCounts + nPixels, 0);
+			return;
+		}
+
+		const Fixed128 y = Fixed128(worldY.hi) + Fixed128(worldY.lo);
+
+		for (int i = 0; i < nPixels; i++)
+		{
+			if (!(std::abs(pWorldX[i].hi) <= 2.0))
+				pCounts[i] = 0;
+			else
+				pCounts[i] = MandelbrotCountFixed128<Formula>(Fixed128(pWorldX[i].hi) + Fixed128(pWorldX[i].lo), y);
+		}
+	}
+
+	// Perturbation, a faster alternative to 128 bit fixed point, F7, past the resolution of double
+	// The orbit Z of a reference point C at the center of the view is calculated once in BigFixed,
+	// with enough bits for the pixel spacing, and stored as doubles. Each pixel C + dc then iterates its
+	// difference d from the reference orbit in double, d = 2Zd + d^2 + dc, as d stays small.
+	// The reference point C is taken from the double-double view, so the zoom ends near a pixel spacing
+	// of 1e-30 as in the other modes, and does not go deeper than F7. At 1e-16 and 1e-25 it is about 4 times faster.
+	// A pixel inside the main cardioid or the period-2 bulb is tested at C + dc in double-double, and not iterated
+	// The perturbation row kernels have the signature of the other row kernels, but pWorldX and worldY are the
+	// differences dc of the pixels from C, taken from dxColumns and dyRows
+	struct ReferenceOrbit
+	{
+		std::vector<double> zx;		// Z for each iteration, from Z0 = C
+		std::vector<double> zy;
+		DoubleDouble x;				// C as given for the calculation
+		DoubleDouble y;
+		double cx = 0;				// C rounded to double
+		double cy = 0;
+		bool bEscaped = false;		// The last Z has escaped, before maxCount
+		int nBits = 0;				// Fraction bits used for the calculation
+		BigFixed zxNext;			// The Z after the last one, to extend the orbit when maxCount grows
+		BigFixed zyNext;
+		bool bNucleus = false;		// C is a nucleus, found with the N key or for the view
+		std::vector<double> dxColumns;	// Difference of each pixel column from C, stepped from the top left pixel like the frame columns
+		std::vector<double> dyRows;		// Difference of each pixel row from C, from the top left pixel + y yStep like the frame rows
+		double dcMax = 0;			// Largest difference of a pixel in the view from C
+		std::string sOrigin;		// How the orbit of the current frame was obtained
+	};
+	ReferenceOrbit referenceOrbit;
+	bool bReferenceOrbitUsed = false;	// In the current frame
+
+	// Calculate the reference orbit at the given point, with nFractionBits bits of precision
+	void CalculateReferenceOrbit(const DoubleDouble& centerX, const DoubleDouble& centerY, int nFractionBits)
+	{
+		int nLimbs = BigFixed::LimbsForFractionBits(nFractionBits);
+
+		ReferenceOrbit& orbit = referenceOrbit;
+		orbit.zx.clear();
+		orbit.zy.clear();
+		orbit.x = centerX;
+		orbit.y = centerY;
+		orbit.zxNext = BigFixed(centerX.hi, nLimbs) + BigFixed(centerX.lo, nLimbs);
+		orbit.zyNext = BigFixed(centerY.hi, nLimbs) + BigFixed(centerY.lo, nLimbs);
+		orbit.cx = orbit.zxNext.ToDouble();
+		orbit.cy = orbit.zyNext.ToDouble();
+		orbit.bEscaped = false;
+		orbit.nBits = 64 * (nLimbs - 1);
+
+		ExtendReferenceOrbit();
+	}
+
+	// Continue the reference orbit up to maxCount, from where it ended
+	void ExtendReferenceOrbit()
+	{
+		ReferenceOrbit& orbit = referenceOrbit;
+		int nLimbs = orbit.zxNext.Limbs();
+		const BigFixed cx = BigFixed(orbit.x.hi, nLimbs) + BigFixed(orbit.x.lo, nLimbs);
+		const BigFixed cy = BigFixed(orbit.y.hi, nLimbs) + BigFixed(orbit.y.lo, nLimbs);
+
+		BigFixed zx = orbit.zxNext;
+		BigFixed zy = orbit.zyNext;
+		for (int count = (int)orbit.zx.size(); count <= maxCount && !orbit.bEscaped; count++)
+		{
+			double x = zx.ToDouble();
+			double y = zy.ToDouble();
+			orbit.zx.push_back(x);
+			orbit.zy.push_back(y);
+
+			if (x * x + y * y > 4.0)
+			{
+				orbit.bEscaped = true;
+				break;
+			}
+
+			BigFixed zx2 = zx * zx;
+			BigFixed zy2 = zy * zy;
+			MandelbrotFormula::Step(zx, zy, zx2, zy2, cx, cy);
+		}
+		orbit.zxNext = zx;
+		orbit.zyNext = zy;
+	}
+
+	// Reference orbit cache
+	// Orbits that took long to calculate are saved in files, keyed by C and the precision, so they are
+	// not calculated again when a location is revisited, also after a restart. The file is mapped into memory,
+	// and has a header, then the doubles of zx and zy, and last the limbs of the next Z for extending the orbit.
+	// The cache is limited in size, and the least recently used orbits are deleted first. The modification time
+	// of a file is its last use, as loading an orbit sets it to the current time
+	static constexpr double fOrbitCacheMinSeconds = 0.25;	// Orbits calculated faster are not saved
+	static constexpr uintmax_t nOrbitCacheMaxBytes = uintmax_t(1) << 30;
+	static constexpr const char* sOrbitCacheDirectory = "OrbitCache";
+
+	struct OrbitCacheHeader
+	{
+		char magic[8];
+		double x[2];		// C as hi and lo of the double-doubles
+		double y[2];
+		int32_t nBits;
+		int32_t bEscaped;
+		int64_t nIterations;
+	};
+	static constexpr char sOrbitCacheMagic[8] = { 'P', 'G', 'E', 'O', 'R', 'B', '1', 0 };
+
+	// The name of the file for the orbit at C with nBits bits, from an FNV-1a hash of the key
+	static std::string OrbitCachePath(const DoubleDouble& x, const DoubleDouble& y, int nBits)
+	{
+		double key[] = { x.hi, x.lo, y.hi, y.lo, (double)nBits };
+		unsigned char bytes[sizeof(key)];
+		std::memcpy(bytes, key, sizeof(key));
+
+		uint64_t hash = 14695981039346656037ull;
+		for (unsigned char b : bytes)
+			hash = (hash ^ b) * 1099511628211ull;
+
+		std::ostringstream s;
+		s << sOrbitCacheDirectory << "/orbit_" << std::hex << hash << ".bin";
+		return s.str();
+	}
+
+	// Load the orbit at C with nBits bits, if it is in the cache
+	bool LoadReferenceOrbit(const DoubleDouble& x, const DoubleDouble& y, int nBits)
+	{
+		MappedFile file(OrbitCachePath(x, y, nBits));
+		if (!file.IsOpen() || file.Size() < sizeof(OrbitCacheHeader))
+			return false;
+
+		OrbitCacheHeader header;
+		std::memcpy(&header, file.Data(), sizeof(header));
+		int nLimbs = BigFixed::LimbsForFractionBits(nBits);
+		if (std::memcmp(header.magic, sOrbitCacheMagic, sizeof(header.magic)) != 0
+			|| header.x[0] != x.hi || header.x[1] != x.lo || header.y[0] != y.hi || header.y[1] != y.lo
+			|| header.nBits != nBits || header.nIterations <= 0
+			|| file.Size() != sizeof(header) + (2 * header.nIterations + 2 * nLimbs) * sizeof(uint64_t))
+			return false;
+
+		std::error_code error;
+		_gfs::last_write_time(OrbitCachePath(x, y, nBits), _gfs::file_time_type::clock::now(), error);
+
+		const double* pZ = (const double*)((const char*)file.Data() + sizeof(header));
+		const uint64_t* pNext = (const uint64_t*)(pZ + 2 * header.nIterations);
+
+		ReferenceOrbit& orbit = referenceOrbit;
+		orbit.zx.assign(pZ, pZ + header.nIterations);
+		orbit.zy.assign(pZ + header.nIterations, pZ + 2 * header.nIterations);
+		orbit.x = x;
+		orbit.y = y;
+		orbit.zxNext = BigFixed(pNext, nLimbs);
+		orbit.zyNext = BigFixed(pNext + nLimbs, nLimbs);
+		orbit.cx = (BigFixed(x.hi, nLimbs) + BigFixed(x.lo, nLimbs)).ToDouble();
+		orbit.cy = (BigFixed(y.hi, nLimbs) + BigFixed(y.lo, nLimbs)).ToDouble();
+		orbit.bEscaped = header.bEscaped != 0;
+		orbit.nBits = nBits;
+		return true;
+	}
+
+	// Save the current orbit in the cache, replacing any earlier and shorter orbit for the same C
+	void SaveReferenceOrbit()
+	{
+		const ReferenceOrbit& orbit = referenceOrbit;
+		int64_t nIterations = (int64_t)orbit.zx.size();
+		int nLimbs = orbit.zxNext.Limbs();
+
+		std::error_code error;
+		_gfs::create_directories(sOrbitCacheDirectory, error);
+
+		std::string sPath = OrbitCachePath(orbit.x, orbit.y, orbit.nBits);
+		{
+			MappedFile file(sPath, sizeof(OrbitCacheHeader) + (2 * nIterations + 2 * nLimbs) * sizeof(uint64_t));
+			if (!file.IsOpen())
+				return;
+
+			OrbitCacheHeader header;
+			std::memcpy(header.magic, sOrbitCacheMagic, sizeof(header.magic));
+			header.x[0] = orbit.x.hi;
+			header.x[1] = orbit.x.lo;
+			header.y[0] = orbit.y.hi;
+			header.y[1] = orbit.y.lo;
+			header.nBits = orbit.nBits;
+			header.bEscaped = orbit.bEscaped ? 1 : 0;
+			header.nIterations = nIterations;
+
+			char* p = (char*)file.Data();
+			std::memcpy(p, &header, sizeof(header));
+			p += sizeof(header);
+			std::memcpy(p, orbit.zx.data(), nIterations * sizeof(double));
+			p += nIterations * sizeof(double);
+			std::memcpy(p, orbit.zy.data(), nIterations * sizeof(double));
+			p += nIterations * sizeof(double);
+			std::memcpy(p, orbit.zxNext.LimbData(), nLimbs * sizeof(uint64_t));
+			p += nLimbs * sizeof(uint64_t);
+			std::memcpy(p, orbit.zyNext.LimbData(), nLimbs * sizeof(uint64_t));
+		}
+
+		// The file is closed first, so its size and time are final
+		EvictOrbitCache(sPath);
+	}
+
+	// Delete the least recently used orbits while the cache is larger than nOrbitCacheMaxBytes,
+	// keeping the orbit just saved
+	static void EvictOrbitCache(const std::string& sKeep)
+	{
+		struct CachedOrbit
+		{
+			_gfs::path path;
+			_gfs::file_time_type lastUse;
+			uintmax_t nBytes;
+		};
+		std::vector<CachedOrbit> orbits;
+		uintmax_t nTotalBytes = 0;
+
+		std::error_code error;
+		for (_gfs::directory_iterator it(sOrbitCacheDirectory, error), end; !error && it != end; it.increment(error))
+		{
+			const _gfs::path& path = it->path();
+			if (path.extension() != ".bin" || path.filename().string().rfind("orbit_", 0) != 0)
+				continue;
+
+			CachedOrbit orbit{ path, _gfs::last_write_time(path, error), _gfs::file_size(path, error) };
+			if (error)
+				return;
+			nTotalBytes += orbit.nBytes;
+			orbits.push_back(orbit);
+		}
+
+		std::sort(orbits.begin(), orbits.end(), [](const CachedOrbit& a, const CachedOrbit& b) { return a.lastUse < b.lastUse; });
+		for (const CachedOrbit& orbit : orbits)
+		{
+			if (nTotalBytes <= nOrbitCacheMaxBytes)
+				break;
+			if (orbit.path == _gfs::path(sKeep))
+				continue;
+			if (_gfs::remove(orbit.path, error))
+				nTotalBytes -= orbit.nBytes;
+		}
+	}
+
+	// Iterate the difference d from the reference orbit, starting from d at iteration startCount
+	int MandelbrotCountPerturbation(double dcx, double dcy, int startCount, double dx, double dy)
+	{
+		const ReferenceOrbit& orbit = referenceOrbit;
+		const int last = (int)orbit.zx.size() - 1;
+
+		for (int count = startCount; count < maxCount; count++)
+		{
+			double Zx = orbit.zx[count];
+			double Zy = orbit.zy[count];
+			double zx = Zx + dx;
+			double zy = Zy + dy;
+			if (zx * zx + zy * zy > 4.0)
+				return count;
+
+			if (count == last)
+			{
+				// The reference escaped before this pixel, which continues from its full value in plain double
+				double cx = orbit.cx + dcx;
+				double cy = orbit.cy + dcy;
+				while (count < maxCount && zx * zx + zy * zy <= 4.0)
+				{
+					double t = zx * zx - zy * zy + cx;
+					zy = (zy + zy) * zx + cy;
+					zx = t;
+					count++;
+				}
+				return count;
+			}
+
+			// d = (2Z + d) * d + dc
+			double tx = Zx + Zx + dx;
+			double ty = Zy + Zy + dy;
+			double t = tx * dx - ty * dy + dcx;
+			dy = tx * dy + ty * dx + dcy;
+			dx = t;
+		}
+
+		return maxCount;
+	}
+
+	// Is the pixel at C + dc inside the main cardioid or the period-2 bulb
+	bool PerturbationInterior(double dcx, double dcy)
+	{
+		return InMainCardioidOrPeriod2Bulb(referenceOrbit.x + dcx, referenceOrbit.y + dcy);
+	}
+
+	int MandelbrotCountPerturbation(double dcx, double dcy)
+	{
+		if (PerturbationInterior(dcx, dcy))
+			return maxCount;
+
+		return MandelbrotCountPerturbation(dcx, dcy, 0, dcx, dcy);
+	}
+
+	// The row kernel of plain perturbation
+	void MandelbrotRowPerturbation(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		for (int x = 0; x < nPixels; x++)
+			pCounts[x] = MandelbrotCountPerturbation(pWorldX[x], worldY);
+	}
+
+	// Series approximation for perturbation
+	// The difference of a pixel from the reference orbit is approximated by a series in dc,
+	// d_n = A_n dc + B_n dc^2 + C_n dc^3, where the coefficients only depend on the reference orbit,
+	// A_n+1 = 2 Z_n A_n + 1, B_n+1 = 2 Z_n B_n + A_n^2 and C_n+1 = 2 Z_n C_n + 2 A_n B_n, from d_0 = dc.
+	// As long as the series is accurate for the whole tile, all its pixels start at iteration N from the series
+	struct SeriesCoefficients
+	{
+		std::vector<std::complex<double>> a;
+		std::vector<std::complex<double>> b;
+		std::vector<std::complex<double>> c;
+	};
+	SeriesCoefficients seriesCoefficients;
+
+	static constexpr int nSeriesTileSize = 32;			// Pixels in each direction of a tile sharing the skip
+	static constexpr double fSeriesTolerance = 1e-12;	// Largest last term of the series at the probes, relative to the series
+
+	std::atomic<int64_t> nSeriesSkippedIterations{ 0 };	// In the current frame
+
+	void CalculateSeriesCoefficients()
+	{
+		const ReferenceOrbit& orbit = referenceOrbit;
+		SeriesCoefficients& series = seriesCoefficients;
+
+		series.a.assign(1, 1.0);
+		series.b.assign(1, 0.0);
+		series.c.assign(1, 0.0);
+
+		for (size_t n = 0; n + 1 < orbit.zx.size(); n++)
+		{
+			std::complex<double> z2 = 2.0 * std::complex<double>(orbit.zx[n], orbit.zy[n]);
+			std::complex<double> a = series.a[n], b = series.b[n], c = series.c[n];
+			series.a.push_back(z2 * a + 1.0);
+			series.b.push_back(z2 * b + a * a);
+			series.c.push_back(z2 * c + 2.0 * a * b);
+		}
+	}
+
+	std::complex<double> SeriesDelta(int n, std::complex<double> dc)
+	{
+		const SeriesCoefficients& series = seriesCoefficients;
+		return ((series.c[n] * dc + series.b[n]) * dc + series.a[n]) * dc;
+	}
+
+	// The number of iterations the series can skip for a tile, tested at probe points, the corners and the center of the tile.
+	// The error of the truncated series is bounded by its last term, C_n dc^3, which must stay below the tolerance
+	// relative to the series value d_n at each probe. The skip also stops before any probe escapes, or the reference ends
+	int SeriesSkip(const std::complex<double>* pProbes, int nProbes)
+	{
+		const ReferenceOrbit& orbit = referenceOrbit;
+		const SeriesCoefficients& series = seriesCoefficients;
+		const int last = std::min((int)orbit.zx.size() - 1, maxCount);
+
+		for (int n = 0; n < last; n++)
+		{
+			std::complex<double> Z(orbit.zx[n], orbit.zy[n]);
+			for (int i = 0; i < nProbes; i++)
+			{
+				std::complex<double> d = SeriesDelta(n, pProbes[i]);
+				double truncation = std::abs(series.c[n]) * std::pow(std::abs(pProbes[i]), 3);
+				if (std::norm(Z + d) > 4.0 || !(truncation <= fSeriesTolerance * std::abs(d)))
+					return std::max(n - 1, 0);
+			}
+		}
+
+		return std::max(last - 1, 0);
+	}
+
+	// Calculate and draw a tile, at the same pixel differences from the reference point as the perturbation rows
+	void DrawTileSeries(int tileX, int tileY, int width, int height)
+	{
+		const double* pDcX = &referenceOrbit.dxColumns[tileX];
+		auto DcY = [&](int y) { return referenceOrbit.dyRows[tileY + y]; };
+
+		std::complex<double> probes[] = {
+			{ pDcX[0], DcY(0) }, { pDcX[width - 1], DcY(0) },
+			{ pDcX[0], DcY(height - 1) }, { pDcX[width - 1], DcY(height - 1) },
+			{ pDcX[width / 2], DcY(height / 2) } };
+		int skip = SeriesSkip(probes, 5);
+		const std::complex<double> Z(referenceOrbit.zx[skip], referenceOrbit.zy[skip]);
+
+		int64_t nSkippedIterations = 0;
+
+		for (int y = 0; y < height; y++)
+		{
+			double dcy = DcY(y);
+			for (int x = 0; x < width; x++)
+			{
+				double dcx = pDcX[x];
+				std::complex<double> d = SeriesDelta(skip, { dcx, dcy });
+				int count;
+				if (PerturbationInterior(dcx, dcy))
+					count = maxCount;
+				else if (skip > 0 && std::norm(Z + d) > 4.0)
+				{
+					// The pixel escaped by the skip, at an iteration the series cannot tell, so it starts over without it
+					count = MandelbrotCountPerturbation(dcx, dcy);
+				}
+				else
+				{
+					count = MandelbrotCountPerturbation(dcx, dcy, skip, d.real(), d.imag());
+					nSkippedIterations += skip;
+				}
+				Draw(tileX + x, tileY + y, CountToPixel(count));
+			}
+		}
+
+		nSeriesSkippedIterations += nSkippedIterations;
+	}
+
+	// Bilinear approximation, BLA, for perturbation
+	// While the difference d is small compared with Z, the step d = 2Zd + d^2 + dc is close to linear in d and dc,
+	// and a run of steps combines into one step d = A d + B dc. The table has a level for each power of two,
+	// where entry i of level l combines the 2^l steps from iteration i * 2^l. Merging x followed by y gives
+	// A = Ay Ax and B = Ay Bx + By. Each entry is valid while |d| is below its radius R. A single step neglects
+	// d^2, which is below epsilon |A d| while |d| < epsilon |A|, so R = epsilon |A|, as its B dc term is exact.
+	// The merged radius keeps d within the radius of y after x, R = min(Rx, max(0, (Ry - |Bx| dcMax) / |Ax|))
+	struct BlaStep
+	{
+		std::complex<double> a;
+		std::complex<double> b;
+		double r2;		// The squared validity radius
+		double aAbs;	// |A| and |B|, for the error bound of MandelbrotCountRebasing
+		double bAbs;
+	};
+	std::vector<std::vector<BlaStep>> blaTable;
+
+	// The accurate end of the usual range of 2^-24 to 2^-32 for double. The counts that still change are those of
+	// pixels so close to an escape that moving them by a millionth of a pixel changes them as well
+	static constexpr double fBlaEpsilon = 0x1p-32;		// Largest relative size of the neglected d^2
+
+	std::atomic<int64_t> nBlaSkippedIterations{ 0 };	// In the current frame
+
+	// dcMax is the largest difference from the reference of the pixels in the view
+	void CalculateBlaTable(double dcMax)
+	{
+		const ReferenceOrbit& orbit = referenceOrbit;
+		const int nSteps = std::min((int)orbit.zx.size() - 1, maxCount);
+
+		blaTable.clear();
+
+		std::vector<BlaStep> level;
+		for (int n = 0; n < nSteps; n++)
+		{
+			std::complex<double> Z(orbit.zx[n], orbit.zy[n]);
+			double a = 2.0 * std::abs(Z);
+			double r = fBlaEpsilon * a;
+			level.push_back({ 2.0 * Z, 1.0, r * r, a, 1.0 });
+		}
+		blaTable.push_back(level);
+
+		while (blaTable.back().size() >= 2)
+		{
+			const std::vector<BlaStep>& lower = blaTable.back();
+			std::vector<BlaStep> merged;
+			for (size_t i = 0; i + 1 < lower.size(); i += 2)
+			{
+				const BlaStep& x = lower[i];
+				const BlaStep& y = lower[i + 1];
+				double ry = (std::sqrt(y.r2) - std::abs(x.b) * dcMax) / std::abs(x.a);
+				double r = std::max(0.0, std::min(std::sqrt(x.r2), ry));
+				std::complex<double> a = y.a * x.a;
+				std::complex<double> b = y.a * x.b + y.b;
+				merged.push_back({ a, b, r * r, std::abs(a), std::abs(b) });
+			}
+			blaTable.push_back(std::move(merged));
+		}
+	}
+
+	// Iterate the difference from the reference orbit, taking the largest valid BLA step at each iteration
+	// The steps of more than one iteration are from level 1 and up, so they are not taken past the end of the
+	// reference. Otherwise one ordinary perturbation step is done, with the escape test
+	int MandelbrotCountBla(double dcx, double dcy, int64_t& nSkippedIterations)
+	{
+		if (PerturbationInterior(dcx, dcy))
+			return maxCount;
+
+		const ReferenceOrbit& orbit = referenceOrbit;
+		const int last = (int)orbit.zx.size() - 1;
+		const std::complex<double> dc(dcx, dcy);
+
+		double dx = dcx;
+		double dy = dcy;
+
+		int count = 0;
+		while (count < maxCount)
+		{
+			// The highest level with an entry starting at this iteration
+			// A merged step is never valid further than the single step it starts with
+			double d2 = dx * dx + dy * dy;
+			int level = 0;
+			if (count < (int)blaTable[0].size() && d2 < blaTable[0][count].r2)
+			{
+				while (level + 1 < (int)blaTable.size() && count % (2 << level) == 0)
+					level++;
+			}
+
+			for (; level >= 1; level--)
+			{
+				int span = 1 << level;
+				if (count + span > last || count + span > maxCount)
+					continue;
+
+				const BlaStep& step = blaTable[level][count >> level];
+				if (d2 < step.r2)
+				{
+					std::complex<double> d = step.a * std::complex<double>(dx, dy) + step.b * dc;
+					dx = d.real();
+					dy = d.imag();
+					count += span;
+					nSkippedIterations += span;
+					break;
+				}
+			}
+			if (level >= 1)
+				continue;
+
+			double Zx = orbit.zx[count];
+			double Zy = orbit.zy[count];
+			double zx = Zx + dx;
+			double zy = Zy + dy;
+			if (zx * zx + zy * zy > 4.0)
+				return count;
+
+			// The end of the reference is handled by the perturbation count
+			if (count == last)
+				return MandelbrotCountPerturbation(dcx, dcy, count, dx, dy);
+
+			double tx = Zx + Zx + dx;
+			double ty = Zy + Zy + dy;
+			double t = tx * dx - ty * dy + dcx;
+			dy = tx * dy + ty * dx + dcy;
+			dx = t;
+			count++;
+		}
+
+		return maxCount;
+	}
+
+	// The row kernel of BLA, adding up the skipped iterations of the row
+	void MandelbrotRowBla(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		int64_t nSkippedIterations = 0;
+		for (int x = 0; x < nPixels; x++)
+			pCounts[x] = MandelbrotCountBla(pWorldX[x], worldY, nSkippedIterations);
+		nBlaSkippedIterations += nSkippedIterations;
+	}
+
+	// Glitch detection and rebasing, for perturbation with BLA
+	// Where a pixel orbit z comes much closer to zero than the reference orbit Z, the difference d is large
+	// compared with z, and z = Z + d loses its precision. These glitches are detected with Pauldelbrot's
+	// criterion |z| < tolerance |Z|, and the pixel is rebased: it continues with z as the difference from the
+	// point before the start of the reference, Z = 0, which is exact as z is small. Rebasing is also done where
+	// |z| < |d|, which keeps d small and is routine, e.g. near every zero of a nucleus reference, and where the
+	// pixel outlives the reference. Otherwise the pixels iterate as in MandelbrotCountBla.
+	// Only the pixels meeting the criterion are counted as glitched, and those outliving the reference apart from them
+	//
+	// Once a pixel has left the reference, an error of z grows by |2z| at every iteration, as in plain double, and
+	// near the boundary the rounding of double changes counts by hundreds. So the kernel carries a bound E on the
+	// error of z. Every step multiplies it by |2z|, or by |A| for a BLA step, and adds the rounding of the step, and a
+	// BLA step adds up to epsilon |A d + B dc| for each iteration it spans. A pixel is uncertain where E reaches
+	// fUncertainError or |z| is within E of the escape radius, and it returns -1. Uncertain pixels are calculated
+	// again without BLA, which leaves only the rounding, and those still uncertain in 128 bit fixed point, as F7
+	static constexpr double fGlitchTolerance = 1e-3;
+	static constexpr double fRoundingUnits = 2.0;		// Rounding of a step, in units of epsilon of its terms
+	static constexpr double fUncertainError = 0.25;
+
+	std::atomic<int64_t> nRebasedPixels{ 0 };			// In the current frame
+	std::atomic<int64_t> nReferenceEndPixels{ 0 };		// Rebased only at the end of the reference, in the current frame
+	std::atomic<int64_t> nUncertainBlaPixels{ 0 };		// Calculated again without BLA, in the current frame
+	std::atomic<int64_t> nUncertainPixels{ 0 };			// Calculated in 128 bit fixed point, in the current frame
+
+	int MandelbrotCountRebasing(double dcx, double dcy, bool bBla, int64_t& nSkippedIterations, bool& bGlitched, bool& bReferenceEnd)
+	{
+		if (PerturbationInterior(dcx, dcy))
+			return maxCount;
+
+		const ReferenceOrbit& orbit = referenceOrbit;
+		const int last = (int)orbit.zx.size() - 1;
+		const std::complex<double> dc(dcx, dcy);
+		const double dcAbs = std::abs(dc);
+		const double rounding = fRoundingUnits * std::numeric_limits<double>::epsilon();
+
+		double dx = dcx;
+		double dy = dcy;
+		double e = 0.0;		// The bound on the error of d, and so of z apart from the rounding of Z + d
+
+		int n = 0;		// Iteration of the reference orbit, behind count after rebasing
+
+		int count = 0;
+		while (count < maxCount)
+		{
+			double d2 = dx * dx + dy * dy;
+			int level = 0;
+			if (bBla && n < (int)blaTable[0].size() && d2 < blaTable[0][n].r2)
+			{
+				while (level + 1 < (int)blaTable.size() && n % (2 << level) == 0)
+					level++;
+			}
+
+			for (; level >= 1; level--)
+			{
+				int span = 1 << level;
+				if (n + span > last || count + span > maxCount)
+					continue;
+
+				const BlaStep& step = blaTable[level][n >> level];
+				if (d2 < step.r2)
+				{
+					e = step.aAbs * e + (span * fBlaEpsilon + rounding) * (step.aAbs * std::sqrt(d2) + step.bAbs * dcAbs);
+					if (e > fUncertainError)
+						return -1;
+
+					std::complex<double> d = step.a * std::complex<double>(dx, dy) + step.b * dc;
+					dx = d.real();
+					dy = d.imag();
+					n += span;
+					count += span;
+					nSkippedIterations += span;
+					break;
+				}
+			}
+			if (level >= 1)
+				continue;
+
+			double Zx = orbit.zx[n];
+			double Zy = orbit.zy[n];
+			double zx = Zx + dx;
+			double zy = Zy + dy;
+			double z2 = zx * zx + zy * zy;
+
+			// The error of z, with the rounding of Z and of the sum
+			// While e is below fUncertainError, |z| cannot be within it of the escape radius for z2 up to 3
+			if (e > fUncertainError)
+				return -1;
+			double dAbs = std::abs(dx) + std::abs(dy);
+			if (z2 > 3.0)
+			{
+				double ez = e + rounding * (std::abs(Zx) + std::abs(Zy) + dAbs);
+				if (std::abs(z2 - 4.0) <= ez * (4.0 + ez))
+					return -1;
+				if (z2 > 4.0)
+					return count;
+			}
+
+			double z = std::sqrt(z2);
+			bool bGlitch = z2 < fGlitchTolerance * fGlitchTolerance * (Zx * Zx + Zy * Zy);
+			if (bGlitch || z2 < d2 || n == last)
+			{
+				// The step from Z = 0 with d = z gives d = z^2 + dc, the difference from Z0 = C
+				// Its d is z itself, so the rounding of Z + d is now part of the error of d
+				bGlitched = bGlitched || bGlitch;
+				bReferenceEnd = bReferenceEnd || n == last;
+				double ez = e + rounding * (std::abs(Zx) + std::abs(Zy) + dAbs);
+				e = 2.0 * z * ez + rounding * (z2 + dcAbs);
+				double t = zx * zx - zy * zy + dcx;
+				dy = (zy + zy) * zx + dcy;
+				dx = t;
+				n = 0;
+				count++;
+				continue;
+			}
+
+			double tx = Zx + Zx + dx;
+			double ty = Zy + Zy + dy;
+			e = 2.0 * z * e + rounding * ((std::abs(tx) + std::abs(ty)) * dAbs + dcAbs);
+			double t = tx * dx - ty * dy + dcx;
+			dy = tx * dy + ty * dx + dcy;
+			dx = t;
+			n++;
+			count++;
+		}
+
+		// BLA steps may have reached maxCount without an escape test
+		return e > fUncertainError ? -1 : maxCount;
+	}
+
+	// The row kernel of rebasing, counting the glitched pixels apart from those only outliving the reference,
+	// and the uncertain pixels
+	void MandelbrotRowRebasing(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		const ReferenceOrbit& orbit = referenceOrbit;
+		const Fixed128 cx = Fixed128(orbit.x.hi) + Fixed128(orbit.x.lo);
+		const Fixed128 cy = Fixed128(orbit.y.hi) + Fixed128(orbit.y.lo) + Fixed128(worldY);
+
+		int64_t nSkippedIterations = 0;
+		int64_t nGlitched = 0;
+		int64_t nReferenceEnd = 0;
+		int64_t nUncertainBla = 0;
+		int64_t nUncertain = 0;
+		for (int x = 0; x < nPixels; x++)
+		{
+			bool bGlitched = false;
+			bool bReferenceEnd = false;
+			int count = MandelbrotCountRebasing(pWorldX[x], worldY, true, nSkippedIterations, bGlitched, bReferenceEnd);
+			if (count < 0)
+			{
+				nUncertainBla++;
+				count = MandelbrotCountRebasing(pWorldX[x], worldY, false, nSkippedIterations, bGlitched, bReferenceEnd);
+			}
+			if (count < 0)
+			{
+				// As in CheckPerturbationReferencePixels, since Fixed128 wraps around past the square
+				nUncertain++;
+				count = 0;
+				if (std::abs(orbit.cx + pWorldX[x]) <= 2.0 && std::abs(orbit.cy + worldY) <= 2.0)
+					count = MandelbrotCountFixed128<MandelbrotFormula>(cx + Fixed128(pWorldX[x]), cy);
+			}
+			pCounts[x] = count;
+			nGlitched += bGlitched ? 1 : 0;
+			nReferenceEnd += bReferenceEnd && !bGlitched ? 1 : 0;
+		}
+		nBlaSkippedIterations += nSkippedIterations;
+		nRebasedPixels += nGlitched;
+		nReferenceEndPixels += nReferenceEnd;
+		nUncertainBlaPixels += nUncertainBla;
+		nUncertainPixels += nUncertain;
+	}
+
+	// Nucleus finder
+	// The nucleus of a minibrot with period p is the point c where z_p = 0, so its orbit is periodic and never
+	// escapes, which makes it the best reference for perturbation. The period of the nearest minibrot is
+	// the first iteration where a disk of the given radius around c0 maps to a region containing 0,
+	// |z_n| < radius |dz_n/dc| to first order. Newton's method then solves z_p(c) = 0 from c0, with
+	// c_k+1 = c_k - z_p / dz_p, where z is iterated in double-double and the correction in double
+	struct Nucleus
+	{
+		DoubleDouble x;
+		DoubleDouble y;
+		int nPeriod = 0;		// 0 when no nucleus has been found
+		int nNewtonSteps = 0;
+	};
+	Nucleus nucleus;
+
+	static constexpr int nNucleusSearchPixels = 16;		// Radius in pixels of the disk searched for a period
+	static constexpr int nNewtonMaxSteps = 64;
+
+	// Both parts with all their digits, as hi+lo, so the location can be reproduced exactly
+	static std::string DoubleDoubleToString(const DoubleDouble& d)
+	{
+		std::ostringstream s;
+		s.precision(17);
+		s << d.hi << std::showpos << d.lo;
+		return s.str();
+	}
+
+	// The period of the nearest minibrot, or 0 if the disk escapes, or has no period up to maxCount
+	int FindPeriod(const DoubleDouble& cx, const DoubleDouble& cy, double radius)
+	{
+		DoubleDouble zx = 0.0;
+		DoubleDouble zy = 0.0;
+		std::complex<double> dz = 0.0;
+
+		for (int n = 1; n <= maxCount; n++)
+		{
+			dz = 2.0 * std::complex<double>(zx.hi, zy.hi) * dz + 1.0;
+			DoubleDouble zx2 = zx * zx;
+			DoubleDouble zy2 = zy * zy;
+			MandelbrotFormula::Step(zx, zy, zx2, zy2, cx, cy);
+
+			double z2 = zx.hi * zx.hi + zy.hi * zy.hi;
+			if (z2 > 4.0)
+				return 0;
+			if (z2 < radius * radius * std::norm(dz))
+				return n;
+		}
+
+		return 0;
+	}
+
+	// Newton's method for the nucleus of the given period from c0, the result has period 0 if it does not converge
+	void FindNucleus(const DoubleDouble& x0, const DoubleDouble& y0, int nPeriod, Nucleus& result)
+	{
+		result = Nucleus();
+		if (nPeriod == 0)
+			return;
+
+		DoubleDouble cx = x0;
+		DoubleDouble cy = y0;
+		double previousStep = std::numeric_limits<double>::infinity();
+
+		for (int step = 1; step <= nNewtonMaxSteps; step++)
+		{
+			DoubleDouble zx = 0.0;
+			DoubleDouble zy = 0.0;
+			std::complex<double> dz = 0.0;
+			for (int n = 0; n < nPeriod; n++)
+			{
+				dz = 2.0 * std::complex<double>(zx.hi, zy.hi) * dz + 1.0;
+				DoubleDouble zx2 = zx * zx;
+				DoubleDouble zy2 = zy * zy;
+				MandelbrotFormula::Step(zx, zy, zx2, zy2, cx, cy);
+			}
+
+			std::complex<double> correction = std::complex<double>(zx.hi, zy.hi) / dz;
+			double size = std::abs(correction);
+			if (!std::isfinite(size))
+				return;
+
+			cx = cx - DoubleDouble(correction.real());
+			cy = cy - DoubleDouble(correction.imag());
+
+			// Converged at the precision of double-double, where the corrections stop getting smaller
+			double resolution = 1e-31 * std::max(std::abs(cx.hi), std::abs(cy.hi));
+			if (size <= resolution || (size >= previousStep && previousStep <= 1e-20))
+			{
+				result = { cx, cy, nPeriod, step };
+				return;
+			}
+			previousStep = size;
+		}
+	}
+
+	// The portable row kernels, each instantiated for every formula
+	enum class RowKernel { Portable, PortableFloat, Interleaved, Blocked4, Blocked8, Blocked16, Blocked4Float, Blocked8Float, Blocked16Float };
+
+	template <typename Formula>
+	static MandelbrotRowFunction PgeMandelbrotParallel::* FormulaRowKernel(RowKernel kernel)
+	{
+		switch (kernel)
+		{
+#if defined(USE_STD_SIMD)
+		case RowKernel::Portable: return &PgeMandelbrotParallel::MandelbrotRowStdSimd<Formula, double, nPortableLanes>;
+		case RowKernel::PortableFloat: return &PgeMandelbrotParallel::MandelbrotRowStdSimd<Formula, float, 2 * nPortableLanes>;
+		case RowKernel::Blocked4: return &PgeMandelbrotParallel::MandelbrotRowBlocked<Formula, double, nPortableLanes, 4>;
+		case RowKernel::Blocked8: return &PgeMandelbrotParallel::MandelbrotRowBlocked<Formula, double, nPortableLanes, 8>;
+		case RowKernel::Blocked16: return &PgeMandelbrotParallel::MandelbrotRowBlocked<Formula, double, nPortableLanes, 16>;
+		case RowKernel::Blocked4Float: return &PgeMandelbrotParallel::MandelbrotRowBlocked<Formula, float, 2 * nPortableLanes, 4>;
+		case RowKernel::Blocked8Float: return &PgeMandelbrotParallel::MandelbrotRowBlocked<Formula, float, 2 * nPortableLanes, 8>;
+		case RowKernel::Blocked16Float: return &PgeMandelbrotParallel::MandelbrotRowBlocked<Formula, float, 2 * nPortableLanes, 16>;
+#endif
+		case RowKernel::Interleaved: return &PgeMandelbrotParallel::MandelbrotRowInterleaved<Formula, 4>;
+		default: return &PgeMandelbrotParallel::MandelbrotRowScalar<Formula>;
+		}
+	}
+
+	// Define a struct for information about an iteration formula
+	struct FormulaDescription
+	{
+		olc::Key commandKey;		// Key to select this formula
+		std::string commandKeyName;	// Name of Key for display
+		std::string description;	// Description of this formula
+		bool bMandelbrot;			// The intrinsic SIMD kernels only implement the Mandelbrot formula
+		MandelbrotRowFunction PgeMandelbrotParallel::* (*pRowKernel)(RowKernel kernel);
+									// Returns the row kernels instantiated for this formula
+		MandelbrotRowDoubleDoubleFunction PgeMandelbrotParallel::* pRowDoubleDouble;
+									// The double-double row kernel for this formula
+		MandelbrotRowDoubleDoubleFunction PgeMandelbrotParallel::* pRowFixed128;
+									// The fixed point row kernel for this formula
+	};
+
+	// The description of a formula, with all its kernel instances
+	template <typename Formula>
+	static FormulaDescription DescribeFormula(olc::Key commandKey, std::string commandKeyName, std::string description)
+	{
+		return { commandKey, commandKeyName, description, std::is_same_v<Formula, MandelbrotFormula>,
+			&PgeMandelbrotParallel::FormulaRowKernel<Formula>,
+			&PgeMandelbrotParallel::MandelbrotRowDoubleDouble<Formula>,
+			&PgeMandelbrotParallel::MandelbrotRowFixed128<Formula> };
+	}
+
+	// Vector of the selectable formulas
+	// Initialized at the bottom of this file
+	static std::vector<FormulaDescription> Formulas;
+
+	// Index of the currently selected formula
+	size_t nCurrentFormulaIndex = 0;
+
+	// The given row kernel for the current formula
+	MandelbrotRowFunction PgeMandelbrotParallel::* CurrentRowKernel(RowKernel kernel)
+	{
+		return Formulas[nCurrentFormulaIndex].pRowKernel(kernel);
+	}
+
+	// The inner pixel kernel of the plain draw functions
+	void MandelbrotRowPortable(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		(this->*CurrentRowKernel(bFloatPrecision ? RowKernel::PortableFloat : RowKernel::Portable))(pWorldX, worldY, nPixels, pCounts);
+	}
+
+#if defined(USE_X86_SIMD)
+	struct CpuFeatures
+	{
+		bool bAVX2 = false;
+		bool bAVX512 = false;	// AVX-512 Foundation
+	};
+	CpuFeatures cpuFeatures;
+
+	static CpuFeatures DetectCpuFeatures()
+	{
+		CpuFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+		// The instruction set must be supported by the CPU, and the OS must save the registers
+		// XCR0 bits 1 and 2 are the XMM and YMM state, bits 5 to 7 the AVX-512 state
+		int info[4];
+		__cpuid(info, 1);
+		bool osXSave = (info[2] & (1 << 27)) != 0;
+		unsigned long long xcr0 = osXSave ? _xgetbv(0) : 0;
+		__cpuidex(info, 7, 0);
+		features.bAVX2 = (xcr0 & 0x06) == 0x06 && (info[1] & (1 << 5));
+		features.bAVX512 = (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16));
+#else
+		// These also check that the OS saves the registers
+		__builtin_cpu_init();
+		features.bAVX2 = __builtin_cpu_supports("avx2");
+		features.bAVX512 = __builtin_cpu_supports("avx512f");
+#endif
+		return features;
+	}
+
+	// All the SIMD row kernels below do the same operations as MandelbrotCount on the same coordinates,
+	// but without its periodicity check, so interior points run to maxCount. The counts are identical to
+	// MandelbrotCount with nPeriodicityCheckInterval 0
+
+	// Lanes inside the main cardioid or the period-2 bulb start with zx as NaN, so they are never active,
+	// and their counts are set to maxCount after the loop
+	// A lane with all bits set is a NaN, so or'ing the interior mask into zx is enough for SSE2 and AVX2
+	// The same calculation as InMainCardioidOrPeriod2Bulb, for each instruction set
+
+	static __m128d InteriorMaskSSE2(__m128d x, __m128d y)
+	{
+		__m128d xq = _mm_sub_pd(x, _mm_set1_pd(0.25));
+		__m128d y2 = _mm_mul_pd(y, y);
+		__m128d q = _mm_add_pd(_mm_mul_pd(xq, xq), y2);
+		__m128d xb = _mm_add_pd(x, _mm_set1_pd(1.0));
+		__m128d cardioid = _mm_cmple_pd(_mm_mul_pd(q, _mm_add_pd(q, xq)), _mm_mul_pd(_mm_set1_pd(0.25), y2));
+		__m128d bulb = _mm_cmple_pd(_mm_add_pd(_mm_mul_pd(xb, xb), y2), _mm_set1_pd(0.0625));
+		return _mm_or_pd(cardioid, bulb);
+	}
+
+	static __m128 InteriorMaskSSE2(__m128 x, __m128 y)
+	{
+		__m128 xq = _mm_sub_ps(x, _mm_set1_ps(0.25f));
+		__m128 y2 = _mm_mul_ps(y, y);
+		__m128 q = _mm_add_ps(_mm_mul_ps(xq, xq), y2);
+		__m128 xb = _mm_add_ps(x, _mm_set1_ps(1.0f));
+		__m128 cardioid = _mm_cmple_ps(_mm_mul_ps(q, _mm_add_ps(q, xq)), _mm_mul_ps(_mm_set1_ps(0.25f), y2));
+		__m128 bulb = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(xb, xb), y2), _mm_set1_ps(0.0625f));
+		return _mm_or_ps(cardioid, bulb);
+	}
+
+	TARGET_AVX2 static __m256d InteriorMaskAVX2(__m256d x, __m256d y)
+	{
+		__m256d xq = _mm256_sub_pd(x, _mm256_set1_pd(0.25));
+		__m256d y2 = _mm256_mul_pd(y, y);
+		__m256d q = _mm256_add_pd(_mm256_mul_pd(xq, xq), y2);
+		__m256d xb = _mm256_add_pd(x, _mm256_set1_pd(1.0));
+		__m256d cardioid = _mm256_cmp_pd(_mm256_mul_pd(q, _mm256_add_pd(q, xq)), _mm256_mul_pd(_mm256_set1_pd(0.25), y2), _CMP_LE_OQ);
+		__m256d bulb = _mm256_cmp_pd(_mm256_add_pd(_mm256_mul_pd(xb, xb), y2), _mm256_set1_pd(0.0625), _CMP_LE_OQ);
+		return _mm256_or_pd(cardioid, bulb);
+	}
+
+	TARGET_AVX2 static __m256 InteriorMaskAVX2(__m256 x, __m256 y)
+	{
+		__m256 xq = _mm256_sub_ps(x, _mm256_set1_ps(0.25f));
+		__m256 y2 = _mm256_mul_ps(y, y);
+		__m256 q = _mm256_add_ps(_mm256_mul_ps(xq, xq), y2);
+		__m256 xb = _mm256_add_ps(x, _mm256_set1_ps(1.0f));
+		__m256 cardioid = _mm256_cmp_ps(_mm256_mul_ps(q, _mm256_add_ps(q, xq)), _mm256_mul_ps(_mm256_set1_ps(0.25f), y2), _CMP_LE_OQ);
+		__m256 bulb = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(xb, xb), y2), _mm256_set1_ps(0.0625f), _CMP_LE_OQ);
+		return _mm256_or_ps(cardioid, bulb);
+	}
+
+	TARGET_AVX512 static __mmask8 InteriorMaskAVX512(__m512d x, __m512d y)
+	{
+		__m512d xq = _mm512_sub_pd(x, _mm512_set1_pd(0.25));
+		__m512d y2 = _mm512_mul_pd(y, y);
+		__m512d q = _mm512_add_pd(_mm512_mul_pd(xq, xq), y2);
+		__m512d xb = _mm512_add_pd(x, _mm512_set1_pd(1.0));
+		__mmask8 cardioid = _mm512_cmp_pd_mask(_mm512_mul_pd(q, _mm512_add_pd(q, xq)), _mm512_mul_pd(_mm512_set1_pd(0.25), y2), _CMP_LE_OQ);
+		__mmask8 bulb = _mm512_cmp_pd_mask(_mm512_add_pd(_mm512_mul_pd(xb, xb), y2), _mm512_set1_pd(0.0625), _CMP_LE_OQ);
+		return cardioid | bulb;
+	}
+
+	TARGET_AVX512 static __mmask16 InteriorMaskAVX512(__m512 x, __m512 y)
+	{
+		__m512 xq = _mm512_sub_ps(x, _mm512_set1_ps(0.25f));
+		__m512 y2 = _mm512_mul_ps(y, y);
+		__m512 q = _mm512_add_ps(_mm512_mul_ps(xq, xq), y2);
+		__m512 xb = _mm512_add_ps(x, _mm512_set1_ps(1.0f));
+		__mmask16 cardioid = _mm512_cmp_ps_mask(_mm512_mul_ps(q, _mm512_add_ps(q, xq)), _mm512_mul_ps(_mm512_set1_ps(0.25f), y2), _CMP_LE_OQ);
+		__mmask16 bulb = _mm512_cmp_ps_mask(_mm512_add_ps(_mm512_mul_ps(xb, xb), y2), _mm512_set1_ps(0.0625f), _CMP_LE_OQ);
+		return cardioid | bulb;
+	}
+
+	// 2 pixels at a time in the double lanes of an SSE2 register
+	// SSE2 is part of the x86-64 baseline, so this is always available
+	void MandelbrotRowSSE2(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		const __m128d four = _mm_set1_pd(4.0);
+		const __m128d cy = _mm_set1_pd(worldY);
+
+		int x = 0;
+		for (; x + 2 <= nPixels; x += 2)
+		{
+			alignas(16) double xs[2];
+			for (int lane = 0; lane < 2; lane++)
+				xs[lane] = pWorldX[x + lane];
+
+			const __m128d cx = _mm_load_pd(xs);
+			const __m128d interior = InteriorMaskSSE2(cx, cy);
+			__m128d zx = _mm_or_pd(cx, interior);
+			__m128d zy = cy;
+			__m128d zx2 = _mm_mul_pd(zx, zx);
+			__m128d zy2 = _mm_mul_pd(zy, zy);
+			__m128i counts = _mm_setzero_si128();
+
+			for (int count = 0; count < maxCount; count++)
+			{
+				__m128d active = _mm_cmple_pd(_mm_add_pd(zx2, zy2), four);
+				if (_mm_movemask_pd(active) == 0)
+					break;
+
+				counts = _mm_sub_epi64(counts, _mm_castpd_si128(active));
+
+				zy = _mm_add_pd(_mm_mul_pd(_mm_add_pd(zy, zy), zx), cy);
+				zx = _mm_add_pd(_mm_sub_pd(zx2, zy2), cx);
+				zx2 = _mm_mul_pd(zx, zx);
+				zy2 = _mm_mul_pd(zy, zy);
+			}
+
+			const __m128i interiorCounts = _mm_and_si128(_mm_castpd_si128(interior), _mm_set1_epi64x(maxCount));
+			counts = _mm_or_si128(_mm_andnot_si128(_mm_castpd_si128(interior), counts), interiorCounts);
+
+			alignas(16) int64_t laneCounts[2];
+			_mm_store_si128((__m128i*)laneCounts, counts);
+			for (int lane = 0; lane < 2; lane++)
+				pCounts[x + lane] = (int)laneCounts[lane];
+		}
+
+		MandelbrotRowScalar(pWorldX + x, worldY, nPixels - x, pCounts + x);
+	}
+
+	// 4 pixels at a time in the float lanes of an SSE2 register
+	void MandelbrotRowSSE2Float(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		const __m128 four = _mm_set1_ps(4.0f);
+		const __m128 cy = _mm_set1_ps((float)worldY);
+
+		// The tail is calculated in float too, with the last pixel repeated in the unused lanes,
+		// so a pixel gets the same count wherever it is in the row
+		for (int x = 0; x < nPixels; x += 4)
+		{
+			alignas(16) float xs[4];
+			for (int lane = 0; lane < 4; lane++)
+				xs[lane] = (float)pWorldX[std::min(x + lane, nPixels - 1)];
+
+			const __m128 cx = _mm_load_ps(xs);
+			const __m128 interior = InteriorMaskSSE2(cx, cy);
+			__m128 zx = _mm_or_ps(cx, interior);
+			__m128 zy = cy;
+			__m128 zx2 = _mm_mul_ps(zx, zx);
+			__m128 zy2 = _mm_mul_ps(zy, zy);
+			__m128i counts = _mm_setzero_si128();
+
+			for (int count = 0; count < maxCount; count++)
+			{
+				__m128 active = _mm_cmple_ps(_mm_add_ps(zx2, zy2), four);
+				if (_mm_movemask_ps(active) == 0)
+					break;
+
+				counts = _mm_sub_epi32(counts, _mm_castps_si128(active));
+
+				zy = _mm_add_ps(_mm_mul_ps(_mm_add_ps(zy, zy), zx), cy);
+				zx = _mm_add_ps(_mm_sub_ps(zx2, zy2), cx);
+				zx2 = _mm_mul_ps(zx, zx);
+				zy2 = _mm_mul_ps(zy, zy);
+			}
+
+			const __m128i interiorCounts = _mm_and_si128(_mm_castps_si128(interior), _mm_set1_epi32(maxCount));
+			counts = _mm_or_si128(_mm_andnot_si128(_mm_castps_si128(interior), counts), interiorCounts);
+
+			alignas(16) int laneCounts[4];
+			_mm_store_si128((__m128i*)laneCounts, counts);
+			std::copy(laneCounts, laneCounts + std::min(4, nPixels - x), pCounts + x);
+		}
+	}
+
+	// 4 pixels at a time in the double lanes of an AVX2 register
+	// Lanes that have escaped are masked off, and the loop stops when all 4 lanes are done
+	TARGET_AVX2 void MandelbrotRowAVX2(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		const __m256d four = _mm256_set1_pd(4.0);
+		const __m256d cy = _mm256_set1_pd(worldY);
+
+		int x = 0;
+		for (; x + 4 <= nPixels; x += 4)
+		{
+			alignas(32) double xs[4];
+			for (int lane = 0; lane < 4; lane++)
+				xs[lane] = pWorldX[x + lane];
+
+			const __m256d cx = _mm256_load_pd(xs);
+			const __m256d interior = InteriorMaskAVX2(cx, cy);
+			__m256d zx = _mm256_or_pd(cx, interior);
+			__m256d zy = cy;
+			__m256d zx2 = _mm256_mul_pd(zx, zx);
+			__m256d zy2 = _mm256_mul_pd(zy, zy);
+			__m256i counts = _mm256_setzero_si256();
+
+			for (int count = 0; count < maxCount; count++)
+			{
+				// All bits are set in the lanes still inside the circle with radius 2
+				__m256d active = _mm256_cmp_pd(_mm256_add_pd(zx2, zy2), four, _CMP_LE_OQ);
+				if (_mm256_testz_pd(active, active))
+					break;
+
+				// An active lane is -1 as an integer, so subtracting increments only those lanes
+				counts = _mm256_sub_epi64(counts, _mm256_castpd_si256(active));
+
+				zy = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(zy, zy), zx), cy);
+				zx = _mm256_add_pd(_mm256_sub_pd(zx2, zy2), cx);
+				zx2 = _mm256_mul_pd(zx, zx);
+				zy2 = _mm256_mul_pd(zy, zy);
+			}
+
+			counts = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(counts), _mm256_castsi256_pd(_mm256_set1_epi64x(maxCount)), interior));
+
+			alignas(32) int64_t laneCounts[4];
+			_mm256_store_si256((__m256i*)laneCounts, counts);
+			for (int lane = 0; lane < 4; lane++)
+				pCounts[x + lane] = (int)laneCounts[lane];
+		}
+
+		MandelbrotRowScalar(pWorldX + x, worldY, nPixels - x, pCounts + x);
+	}
+
+	// 8 pixels at a time in the float lanes of an AVX2 register
+	TARGET_AVX2 void MandelbrotRowAVX2Float(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		const __m256 four = _mm256_set1_ps(4.0f);
+		const __m256 cy = _mm256_set1_ps((float)worldY);
+
+		for (int x = 0; x < nPixels; x += 8)
+		{
+			alignas(32) float xs[8];
+			for (int lane = 0; lane < 8; lane++)
+				xs[lane] = (float)pWorldX[std::min(x + lane, nPixels - 1)];
+
+			const __m256 cx = _mm256_load_ps(xs);
+			const __m256 interior = InteriorMaskAVX2(cx, cy);
+			__m256 zx = _mm256_or_ps(cx, interior);
+			__m256 zy = cy;
+			__m256 zx2 = _mm256_mul_ps(zx, zx);
+			__m256 zy2 = _mm256_mul_ps(zy, zy);
+			__m256i counts = _mm256_setzero_si256();
+
+			for (int count = 0; count < maxCount; count++)
+			{
+				__m256 active = _mm256_cmp_ps(_mm256_add_ps(zx2, zy2), four, _CMP_LE_OQ);
+				if (_mm256_testz_ps(active, active))
+					break;
+
+				counts = _mm256_sub_epi32(counts, _mm256_castps_si256(active));
+
+				zy = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(zy, zy), zx), cy);
+				zx = _mm256_add_ps(_mm256_sub_ps(zx2, zy2), cx);
+				zx2 = _mm256_mul_ps(zx, zx);
+				zy2 = _mm256_mul_ps(zy, zy);
+			}
+
+			counts = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(counts), _mm256_castsi256_ps(_mm256_set1_epi32(maxCount)), interior));
+
+			alignas(32) int laneCounts[8];
+			_mm256_store_si256((__m256i*)laneCounts, counts);
+			std::copy(laneCounts, laneCounts + std::min(8, nPixels - x), pCounts + x);
+		}
+	}
+
+	// 8 pixels at a time in the double lanes of an AVX-512 register
+	// The escape test gives a mask register, which only lets the active lanes be counted
+	TARGET_AVX512 void MandelbrotRowAVX512(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		const __m512d four = _mm512_set1_pd(4.0);
+		const __m512d cy = _mm512_set1_pd(worldY);
+		const __m512i one = _mm512_set1_epi64(1);
+
+		int x = 0;
+		for (; x + 8 <= nPixels; x += 8)
+		{
+			alignas(64) double xs[8];
+			for (int lane = 0; lane < 8; lane++)
+				xs[lane] = pWorldX[x + lane];
+
+			const __m512d cx = _mm512_load_pd(xs);
+			const __mmask8 interior = InteriorMaskAVX512(cx, cy);
+			__m512d zx = _mm512_mask_mov_pd(cx, interior, _mm512_set1_pd(std::numeric_limits<double>::quiet_NaN()));
+			__m512d zy = cy;
+			__m512d zx2 = _mm512_mul_pd(zx, zx);
+			__m512d zy2 = _mm512_mul_pd(zy, zy);
+			__m512i counts = _mm512_setzero_si512();
+
+			for (int count = 0; count < maxCount; count++)
+			{
+				__mmask8 active = _mm512_cmp_pd_mask(_mm512_add_pd(zx2, zy2), four, _CMP_LE_OQ);
+				if (active == 0)
+					break;
+
+				counts = _mm512_mask_add_epi64(counts, active, counts, one);
+
+				zy = _mm512_add_pd(_mm512_mul_pd(_mm512_add_pd(zy, zy), zx), cy);
+				zx = _mm512_add_pd(_mm512_sub_pd(zx2, zy2), cx);
+				zx2 = _mm512_mul_pd(zx, zx);
+				zy2 = _mm512_mul_pd(zy, zy);
+			}
+
+			counts = _mm512_mask_mov_epi64(counts, interior, _mm512_set1_epi64(maxCount));
+
+			// Narrow the 64 bit counts to 32 bit int and store directly
+			_mm512_mask_cvtepi64_storeu_epi32(pCounts + x, 0xFF, counts);
+		}
+
+		MandelbrotRowScalar(pWorldX + x, worldY, nPixels - x, pCounts + x);
+	}
+
+	// 16 pixels at a time in the float lanes of an AVX-512 register
+	// Only usable at shallow zoom, where the precision of float is sufficient
+	TARGET_AVX512 void MandelbrotRowAVX512Float(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		const __m512 four = _mm512_set1_ps(4.0f);
+		const __m512 cy = _mm512_set1_ps((float)worldY);
+		const __m512i one = _mm512_set1_epi32(1);
+
+		for (int x = 0; x < nPixels; x += 16)
+		{
+			alignas(64) float xs[16];
+			for (int lane = 0; lane < 16; lane++)
+				xs[lane] = (float)pWorldX[std::min(x + lane, nPixels - 1)];
+
+			const __m512 cx = _mm512_load_ps(xs);
+			const __mmask16 interior = InteriorMaskAVX512(cx, cy);
+			__m512 zx = _mm512_mask_mov_ps(cx, interior, _mm512_set1_ps(std::numeric_limits<float>::quiet_NaN()));
+			__m512 zy = cy;
+			__m512 zx2 = _mm512_mul_ps(zx, zx);
+			__m512 zy2 = _mm512_mul_ps(zy, zy);
+			__m512i counts = _mm512_setzero_si512();
+
+			for (int count = 0; count < maxCount; count++)
+			{
+				__mmask16 active = _mm512_cmp_ps_mask(_mm512_add_ps(zx2, zy2), four, _CMP_LE_OQ);
+				if (active == 0)
+					break;
+
+				counts = _mm512_mask_add_epi32(counts, active, counts, one);
+
+				zy = _mm512_add_ps(_mm512_mul_ps(_mm512_add_ps(zy, zy), zx), cy);
+				zx = _mm512_add_ps(_mm512_sub_ps(zx2, zy2), cx);
+				zx2 = _mm512_mul_ps(zx, zx);
+				zy2 = _mm512_mul_ps(zy, zy);
+			}
+
+			counts = _mm512_mask_mov_epi32(counts, interior, _mm512_set1_epi32(maxCount));
+
+			// Only the lanes of the pixels in the row are stored
+			_mm512_mask_storeu_epi32(pCounts + x, (__mmask16)((1u << std::min(16, nPixels - x)) - 1), counts);
+		}
+	}
+#endif
+
+	// Select the row kernel for the best instruction set supported by this CPU
+	void SelectMandelbrotRowKernel()
+	{
+#if defined(USE_X86_SIMD)
+		cpuFeatures = DetectCpuFeatures();
+
+		if (cpuFeatures.bAVX512)
+		{
+			pMandelbrotRow = &PgeMandelbrotParallel::MandelbrotRowAVX512;
+			pMandelbrotRowFloat = &PgeMandelbrotParallel::MandelbrotRowAVX512Float;
+			sKernelISA = "AVX-512";
+		}
+		else if (cpuFeatures.bAVX2)
+		{
+			pMandelbrotRow = &PgeMandelbrotParallel::MandelbrotRowAVX2;
+			pMandelbrotRowFloat = &PgeMandelbrotParallel::MandelbrotRowAVX2Float;
+			sKernelISA = "AVX2";
+		}
+		else
+		{
+			pMandelbrotRow = &PgeMandelbrotParallel::MandelbrotRowSSE2;
+			pMandelbrotRowFloat = &PgeMandelbrotParallel::MandelbrotRowSSE2Float;
+			sKernelISA = "SSE2";
+		}
+#else
+		pMandelbrotRow = &PgeMandelbrotParallel::MandelbrotRowScalar;
+		pMandelbrotRowFloat = &PgeMandelbrotParallel::MandelbrotRowScalar;
+		sKernelISA = "Scalar";
+#endif
+	}
+
+	// The inner pixel kernel of the SIMD draw functions, in the precision decided for this frame
+	// Other formulas than Mandelbrot use the portable kernels
+	void MandelbrotRowSIMD(const double* pWorldX, double worldY, int nPixels, int* pCounts)
+	{
+		if (Formulas[nCurrentFormulaIndex].bMandelbrot)
+			(this->*(bFloatPrecision ? pMandelbrotRowFloat : pMandelbrotRow))(pWorldX, worldY, nPixels, pCounts);
+		else
+			MandelbrotRowPortable(pWorldX, worldY, nPixels, pCounts);
+	}
+
+	// The x coordinates of the pixel columns in the current frame, stepped from the left edge by the pixel spacing
+	// Every draw mode takes its coordinates from here, whether it calculates whole rows, parts of rows,
+	// or every nth pixel, so all draw modes calculate exactly the same point for a pixel
+	std::vector<double> frameColumns;
+	std::vector<DoubleDouble> frameColumnsDoubleDouble;
+
+	// Called at the start of each frame, when the view is settled
+	void PrepareFrameColumns()
+	{
+		double xStep = 1.0 / tv.GetWorldScale().x;
+
+		// The grid of solid guessing can end right of the screen
+		int nColumns = ScreenWidth() + nGuessingStep;
+
+		DoubleDouble x = tv.GetPreciseWorldOffset().x;
+		frameColumnsDoubleDouble.resize(nColumns);
+		for (int i = 0; i < nColumns; i++)
+		{
+			frameColumnsDoubleDouble[i] = x;
+			x += xStep;
+		}
+
+		double worldX = tv.GetWorldOffset().x;
+		frameColumns.resize(nColumns);
+		for (int i = 0; i < nColumns; i++)
+		{
+			frameColumns[i] = worldX;
+			worldX += xStep;
+		}
+	}
+
+	// Calculate and draw a single row with the given row kernel
+	void DrawRow(int y, double worldY, MandelbrotRowFunction PgeMandelbrotParallel::* pRow)
+	{
+		// Past the resolution of double every draw mode uses the double-double kernel
+		if (bDoubleDoublePrecision)
+			DrawRowDoubleDouble(y, Formulas[nCurrentFormulaIndex].pRowDoubleDouble);
+		else
+			DrawRowKernel(y, frameColumns.data(), worldY, pRow);
+	}
+
+	// Calculate and draw a single row with exactly the given row kernel, at any zoom
+	void DrawRowKernel(int y, const double* pWorldX, double worldY, MandelbrotRowFunction PgeMandelbrotParallel::* pRow)
+	{
+		std::vector<int> counts(ScreenWidth());
+
+		(this->*pRow)(pWorldX, worldY, ScreenWidth(), counts.data());
+
+		for (int x = 0; x < ScreenWidth(); x++)
+			Draw(x, y, CountToPixel(counts[x]));
+	}
+
+	// The y coordinate of a row in double-double, calculated from the view, as a double can not hold the position of a deep row
+	DoubleDouble RowDoubleDouble(int y)
+	{
+		double yStep = 1.0 / tv.GetWorldScale().y;
+		return tv.GetPreciseWorldOffset().y + DoubleDouble(yStep) * (double)y;
+	}
+
+	// Calculate and draw a single row with a row kernel taking the coordinates in double-double
+	void DrawRowDoubleDouble(int y, MandelbrotRowDoubleDoubleFunction PgeMandelbrotParallel::* pRow)
+	{
+		std::vector<int> counts(ScreenWidth());
+
+		(this->*pRow)(frameColumnsDoubleDouble.data(), RowDoubleDouble(y), ScreenWidth(), counts.data());
+
+		for (int x = 0; x < ScreenWidth(); x++)
+			Draw(x, y, CountToPixel(counts[x]));
+	}
+
+	// The counts of the current frame, for the draw modes that only calculate some of the pixels,
+	// and decide the rest from the counts already calculated
+	std::vector<int> frameCounts;
+
+	std::atomic<int64_t> nFilledPixels{ 0 };	// Pixels set by FillPixel in the current frame, added up by the draw modes
+
+	int& FrameCount(int x, int y)
+	{
+		return frameCounts[(size_t)y * ScreenWidth() + x];
+	}
+
+	// Calculate the counts of nPixels pixels of row y, from x and nStride pixels apart, with the SIMD row kernel,
+	// or double-double where double is not enough
+	// The coordinates of strided pixels are gathered from the frame columns in chunks, for the row kernel
+	static constexpr int nGatherChunk = 64;
+
+	void CalculateCounts(int x, int y, int nStride, int nPixels, int* pCounts)
+	{
+		CalculateCounts(x, y, nStride, nPixels, pCounts, &PgeMandelbrotParallel::MandelbrotRowSIMD, Formulas[nCurrentFormulaIndex].pRowDoubleDouble);
+	}
+
+	// The same with the given row kernels, where the double-double kernel is also used if there is no double kernel
+	void CalculateCounts(int x, int y, int nStride, int nPixels, int* pCounts,
+		MandelbrotRowFunction PgeMandelbrotParallel::* pRow, MandelbrotRowDoubleDoubleFunction PgeMandelbrotParallel::* pRowDoubleDouble)
+	{
+		if (bDoubleDoublePrecision || !pRow)
+		{
+			const DoubleDouble worldY = RowDoubleDouble(y);
+			if (nStride == 1)
+			{
+				(this->*pRowDoubleDouble)(&frameColumnsDoubleDouble[x], worldY, nPixels, pCounts);
+				return;
+			}
+
+			DoubleDouble columns[nGatherChunk];
+			for (int i = 0; i < nPixels; i += nGatherChunk)
+			{
+				int n = std::min(nGatherChunk, nPixels - i);
+				for (int k = 0; k < n; k++)
+					columns[k] = frameColumnsDoubleDouble[x + (i + k) * nStride];
+				(this->*pRowDoubleDouble)(columns, worldY, n, pCounts + i);
+			}
+		}
+		else
+		{
+			double yStep = 1.0 / tv.GetWorldScale().y;
+			const double worldY = tv.GetWorldOffset().y + y * yStep;
+			if (nStride == 1)
+			{
+				(this->*pRow)(&frameColumns[x], worldY, nPixels, pCounts);
+				return;
+			}
+
+			double columns[nGatherChunk];
+			for (int i = 0; i < nPixels; i += nGatherChunk)
+			{
+				int n = std::min(nGatherChunk, nPixels - i);
+				for (int k = 0; k < n; k++)
+					columns[k] = frameColumns[x + (i + k) * nStride];
+				(this->*pRow)(columns, worldY, n, pCounts + i);
+			}
+		}
+	}
+
+	// Calculate and draw nPixels pixels of row y from x, and store the counts in frameCounts
+	void CalculateSegment(int x, int y, int nPixels)
+	{
+		int* pCounts = &FrameCount(x, y);
+		CalculateCounts(x, y, 1, nPixels, pCounts);
+
+		for (int i = 0; i < nPixels; i++)
+			Draw(x + i, y, CountToPixel(pCounts[i]));
+	}
+
+	// The view of a frame, everything the counts of its pixels depend on
+	struct FrameView
+	{
+		DoubleDouble x, y;		// The world offset
+		olc::vd2d scale;
+		int maxCount = 0;
+		size_t nFormula = 0;
+		bool bFloat = false;
+		bool bDoubleDouble = false;
+
+		bool SameExceptOffset(const FrameView& v) const
+		{
+			return scale == v.scale && maxCount == v.maxCount && nFormula == v.nFormula && bFloat == v.bFloat && bDoubleDouble == v.bDoubleDouble;
+		}
+
+		bool operator==(const FrameView& v) const
+		{
+			return x.hi == v.x.hi && x.lo == v.x.lo && y.hi == v.y.hi && y.lo == v.y.lo && SameExceptOffset(v);
+		}
+	};
+
+	FrameView CurrentFrameView()
+	{
+		const Vector2T<DoubleDouble>& worldTopLeft = tv.GetPreciseWorldOffset();
+		return { worldTopLeft.x, worldTopLeft.y, tv.GetWorldScale(), maxCount, nCurrentFormulaIndex, bFloatPrecision, bDoubleDoublePrecision };
+	}
+
+	// Pan reuse
+	// While the view is dragged, it moves by whole pixels, so the last frame is shifted by the pan,
+	// and only the strips exposed at the edges are calculated, with the row kernels of the draw mode.
+	// The draw modes calculating their pixels at the frame columns with one row kernel record it for the frame,
+	// with SetFrameRowKernel. The others, perturbation at its differences from the reference, series in tiles,
+	// and progressive refinement over frames, record none and draw every frame in full.
+	// The kept pixels stay at the coordinates they were calculated at, which can differ from those of the
+	// shifted frame in the last bit, as the columns are stepped from the offset rounded to double
+	bool bPanReuse = true;					// Toggled with the D key
+	bool bPanReused = false;				// In the current frame
+	FrameView panView;						// The view of the kept frame
+	size_t nPanDrawFunctionIndex = 0;		// The draw mode of the kept frame
+	std::vector<olc::Pixel> panPixels;		// The kept frame
+
+	// The row kernels of the current frame and of the kept frame, the double-double one where double is not enough
+	MandelbrotRowFunction PgeMandelbrotParallel::* pFrameRow = nullptr;
+	MandelbrotRowDoubleDoubleFunction PgeMandelbrotParallel::* pFrameRowDoubleDouble = nullptr;
+	MandelbrotRowFunction PgeMandelbrotParallel::* pPanRow = nullptr;
+	MandelbrotRowDoubleDoubleFunction PgeMandelbrotParallel::* pPanRowDoubleDouble = nullptr;
+
+	// Record the row kernel of the current frame, with the double-double kernel DrawRow uses past double
+	void SetFrameRowKernel(MandelbrotRowFunction PgeMandelbrotParallel::* pRow)
+	{
+		pFrameRow = pRow;
+		pFrameRowDoubleDouble = Formulas[nCurrentFormulaIndex].pRowDoubleDouble;
+	}
+
+	// Draw the kept frame shifted by the pan, if the view has only moved by whole pixels since it
+	bool DrawPannedFrame()
+	{
+		int w = ScreenWidth();
+		int h = ScreenHeight();
+		FrameView view = CurrentFrameView();
+		if (!bPanReuse || !tv.IsPanning() || panPixels.size() != (size_t)w * h || !pPanRowDoubleDouble
+			|| nPanDrawFunctionIndex != nCurrentDrawFunctionIndex || !view.SameExceptOffset(panView))
+			return false;
+
+		// The pixels move right and down by the change of the offset in pixels
+		double dx = ToDouble(panView.x - view.x) * view.scale.x;
+		double dy = ToDouble(panView.y - view.y) * view.scale.y;
+		int nShiftX = (int)std::lround(dx);
+		int nShiftY = (int)std::lround(dy);
+		if (std::abs(dx - nShiftX) > 1e-3 || std::abs(dy - nShiftY) > 1e-3 || std::abs(nShiftX) >= w || std::abs(nShiftY) >= h)
+			return false;
+
+		// The rows moved off the kept frame are calculated in full, the others only where their columns are
+		olc::Pixel* pPixels = GetDrawTarget()->GetData();
+		int xKeptBegin = std::max(nShiftX, 0);
+		int xKeptEnd = std::min(w + nShiftX, w);
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int y = 0; y < h; y++)
+		{
+			int yKept = y - nShiftY;
+			std::vector<int> counts(w);
+			auto CalculateStrip = [&](int x, int nPixels)
+				{
+					CalculateCounts(x, y, 1, nPixels, counts.data(), pPanRow, pPanRowDoubleDouble);
+					for (int i = 0; i < nPixels; i++)
+						pPixels[(size_t)y * w + x + i] = CountToPixel(counts[i]);
+				};
+
+			if (yKept < 0 || yKept >= h)
+			{
+				CalculateStrip(0, w);
+				continue;
+			}
+
+			std::copy(panPixels.begin() + (size_t)yKept * w + xKeptBegin - nShiftX, panPixels.begin() + (size_t)yKept * w + xKeptEnd - nShiftX,
+				pPixels + (size_t)y * w + xKeptBegin);
+			if (xKeptBegin > 0)
+				CalculateStrip(0, xKeptBegin);
+			if (xKeptEnd < w)
+				CalculateStrip(xKeptEnd, w - xKeptEnd);
+		}
+		pFrameRow = pPanRow;
+		pFrameRowDoubleDouble = pPanRowDoubleDouble;
+		return true;
+	}
+
+	// Keep the frame just drawn for the next frame
+	void KeepFrame()
+	{
+		const olc::Pixel* pPixels = GetDrawTarget()->GetData();
+		panPixels.assign(pPixels, pPixels + ScreenWidth() * ScreenHeight());
+		panView = CurrentFrameView();
+		nPanDrawFunctionIndex = nCurrentDrawFunctionIndex;
+		pPanRow = pFrameRow;
+		pPanRowDoubleDouble = pFrameRowDoubleDouble;
+	}
+
+	// Set and draw a pixel with a count decided without iterating it
+	void FillPixel(int x, int y, int count)
+	{
+		FrameCount(x, y) = count;
+		Draw(x, y, CountToPixel(count));
+	}
+
+	// The check of the current draw mode against full rows of the SIMD kernel, requested with the C key
+	// The reference is MandelbrotRowSIMD, the kernel of modes 6 to 9, in the precision of the frame, and not
+	// the portable kernel of the single threaded mode 1. Both calculate the same frame at the same coordinates,
+	// and the pixels that differ are counted.
+	// The perturbation modes are checked against 128 bit fixed point instead, at their own coordinates,
+	// and so is plain perturbation, F8, so the modes skipping iterations can be compared with it
+	bool bCheckRequested = false;
+	std::string sCheckResult;
+
+	// The reference of a check, full rows of the SIMD kernel, with double-double where double is not enough, as in every draw mode
+	std::vector<olc::Pixel> CheckReferencePixels()
+	{
+		int w = ScreenWidth();
+		std::vector<olc::Pixel> pixels((size_t)w * ScreenHeight());
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int y = 0; y < ScreenHeight(); y++)
+		{
+			std::vector<int> counts(w);
+			CalculateCounts(0, y, 1, w, counts.data());
+			for (int x = 0; x < w; x++)
+				pixels[(size_t)y * w + x] = CountToPixel(counts[x]);
+		}
+		return pixels;
+	}
+
+	// The reference of a check of perturbation, at the pixels C + dc of the perturbation kernels,
+	// which are rounded to double and so differ a little from the pixels of the frame
+	// The sum is exact in 128 bit fixed point, and the iteration has no rounding, at any zoom with pixels above 1e-30
+	std::vector<olc::Pixel> CheckPerturbationReferencePixels()
+	{
+		const ReferenceOrbit& orbit = referenceOrbit;
+		const Fixed128 cx = Fixed128(orbit.x.hi) + Fixed128(orbit.x.lo);
+		const Fixed128 cy = Fixed128(orbit.y.hi) + Fixed128(orbit.y.lo);
+
+		int w = ScreenWidth();
+		std::vector<olc::Pixel> pixels((size_t)w * ScreenHeight());
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int y = 0; y < ScreenHeight(); y++)
+		{
+			double dcy = orbit.dyRows[y];
+			for (int x = 0; x < w; x++)
+			{
+				double dcx = orbit.dxColumns[x];
+				int count = 0;
+				if (std::abs(orbit.cx + dcx) <= 2.0 && std::abs(orbit.cy + dcy) <= 2.0)
+					count = MandelbrotCountFixed128<MandelbrotFormula>(cx + Fixed128(dcx), cy + Fixed128(dcy));
+				pixels[(size_t)y * w + x] = CountToPixel(count);
+			}
+		}
+		return pixels;
+	}
+
+	// The pixels of plain perturbation, F8, with the current reference orbit
+	std::vector<olc::Pixel> CheckPerturbationPixels()
+	{
+		int w = ScreenWidth();
+		std::vector<olc::Pixel> pixels((size_t)w * ScreenHeight());
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int y = 0; y < ScreenHeight(); y++)
+		{
+			std::vector<int> counts(w);
+			MandelbrotRowPerturbation(referenceOrbit.dxColumns.data(), referenceOrbit.dyRows[y], w, counts.data());
+			for (int x = 0; x < w; x++)
+				pixels[(size_t)y * w + x] = CountToPixel(counts[x]);
+		}
+		return pixels;
+	}
+
+	static int64_t CountDifferentPixels(const olc::Pixel* pPixels, const std::vector<olc::Pixel>& reference)
+	{
+		int64_t nDifferent = 0;
+		for (size_t i = 0; i < reference.size(); i++)
+			nDifferent += pPixels[i] != reference[i] ? 1 : 0;
+		return nDifferent;
+	}
+
+	// The verification level of solid guessing, changed with the L key
+	static constexpr int nGuessingMaxVerification = 3;
+	int nGuessingVerification = 1;
+
+	void DrawSingleThread()
+	{
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowPortable);
+
+		// Current area for calculation must be calculated
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+		// Calculate and draw line by line
+		// The rows are at the same coordinates as in the parallel draw modes, so the images are identical
+		for (int y = 0; y < ScreenHeight(); y++)
+		{
+			DrawRow(y, worldTopLeft.y + y * yStep, &PgeMandelbrotParallel::MandelbrotRowPortable);
+		}
+	}
+
+	void DrawOpenMP()
+	{
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowPortable);
+
+		// Current area for calculation must be calculated
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+		// Calculate and draw line by line
+		// Using OpenMP
+		// There are no dependencies between each y-iteration for the Mandelbrot set
+		// but ensure that no dependencies are created, e.g. reused variable
+		// schedule(dynamic) ensures this non-dependency is used, scheduling the lines as fast as possible
+		// nowait is probably unnecessary in this case
+#pragma omp parallel
+#pragma omp for schedule(dynamic, 1) nowait
+		for (int y = 0; y < ScreenHeight(); y++)
+		{
+			// This must have a separate copy for each possible thread
+			double worldY = worldTopLeft.y + y * yStep;
+			DrawRow(y, worldY, &PgeMandelbrotParallel::MandelbrotRowPortable);
+		}
+	}
+
+	void DrawCpp17ForEach()
+	{
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowPortable);
+
+		// Current area for calculation must be calculated
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+		// Calculate and draw line by line
+		// Using C++17 for_each algorithm with parallel execution
+		// There are no dependencies between each y-iteration for the Mandelbrot set
+		// but ensure that no dependencies are created, e.g. reused variable
+
+		// Create a vector of indices, this is how it is done in standard C++ pre C++20
+		// For C++20 and later, a iota view range may be possible (TBD)
+		std::vector<size_t> indices(ScreenHeight());
+		std::iota(indices.begin(), indices.end(), 0);
+
+		// Use the for_each algorithm with a request for parallel execution
+		// A runtime scheduler will try to use all the cores
+		std::for_each(std::execution::par, indices.begin(), indices.end(),
+			[&](size_t y)
+			{
+				// This must have a separate copy for each possible thread
+				double worldY = worldTopLeft.y + y * yStep;
+				DrawRow((int)y, worldY, &PgeMandelbrotParallel::MandelbrotRowPortable);
+			}
+		);
+	}
+
+#if defined(_MSC_VER)
+	void DrawPPLParallelFor()
+	{
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowPortable);
+
+		// Current area for calculation must be calculated
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+		// Calculate and draw line by line
+		// Using Microsoft concurrency library PPL parallel_for
+		// There are no dependencies between each y-iteration for the Mandelbrot set
+		// but ensure that no dependencies are created, e.g. reused variable
+
+		// Use the parallel_for algorithm
+		// A runtime scheduler will try to use all the cores
+		concurrency::parallel_for(0, ScreenHeight(),
+			[&](size_t y)
+			{
+				// This must have a separate copy for each possible thread
+				double worldY = worldTopLeft.y + y * yStep;
+				DrawRow((int)y, worldY, &PgeMandelbrotParallel::MandelbrotRowPortable);
+			}
+		);
+	}
+#endif
+
+	// The following demands installation of OneTBB for Windows/MSVC to work with MSVC _MSC_VER
+
+#if defined(__GNUG__) || defined(USE_TBB_WITH_MSC)
+	void DrawTBBParallelFor()
+	{
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowPortable);
+
+		// Current area for calculation must be calculated
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+		// Calculate and draw line by line
+		// Using Microsoft concurrency library PPL parallel_for
+		// There are no dependencies between each y-iteration for the Mandelbrot set
+		// but ensure that no dependencies are created, e.g. reused variable
+
+		// Use the parallel_for algorithm
+		// A runtime scheduler will try to use all the cores
+		tbb::parallel_for(0, ScreenHeight(),
+			[&](size_t y)
+			{
+				// This must have a separate copy for each possible thread
+				double worldY = worldTopLeft.y + y * yStep;
+				DrawRow((int)y, worldY, &PgeMandelbrotParallel::MandelbrotRowPortable);
+			}
+		);
+	}
+#endif
+
+	// Prepare the reference orbit for perturbation, at the nucleus found with the N key when it is in the view,
+	// otherwise at the point of the previous orbit while it is in the view and precise enough, otherwise at the
+	// nucleus of the minibrot nearest the center if it is in the view, and last at the center pixel of the view.
+	// A nucleus never escapes, where a reference that escapes leaves the pixels outliving it without a reference
+	// for the rest of their iterations. The orbit of the previous frame is reused for the same point, and extended
+	// if maxCount has grown, and other orbits are loaded from the cache or calculated.
+	// The fraction bits are what the pixel spacing needs, and 64 more for the iterations
+	void PrepareReferenceOrbit()
+	{
+		const Vector2T<DoubleDouble>& worldTopLeft = tv.GetPreciseWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double xStep = 1.0 / worldScale.x;
+		double yStep = 1.0 / worldScale.y;
+
+		double pixelSpacing = std::min(std::abs(xStep), std::abs(yStep));
+		int nBits = 64 * (BigFixed::LimbsForFractionBits(64 - std::ilogb(pixelSpacing)) - 1);
+
+		// The difference of the top left pixel from a point, if the point is in the view
+		auto InView = [&](const DoubleDouble& x, const DoubleDouble& y, double& dxTopLeft, double& dyTopLeft)
+		{
+			dxTopLeft = (worldTopLeft.x - x).hi;
+			dyTopLeft = (worldTopLeft.y - y).hi;
+			double pixelX = -dxTopLeft / xStep;
+			double pixelY = -dyTopLeft / yStep;
+			return pixelX >= 0 && pixelX < ScreenWidth() && pixelY >= 0 && pixelY < ScreenHeight();
+		};
+
+		ReferenceOrbit& orbit = referenceOrbit;
+
+		DoubleDouble referenceX = worldTopLeft.x + DoubleDouble(xStep) * (double)(ScreenWidth() / 2);
+		DoubleDouble referenceY = worldTopLeft.y + DoubleDouble(yStep) * (double)(ScreenHeight() / 2);
+		double dxTopLeft = -(ScreenWidth() / 2) * xStep;
+		double dyTopLeft = -(ScreenHeight() / 2) * yStep;
+
+		auto IsOrbitPoint = [&](const DoubleDouble& x, const DoubleDouble& y)
+		{
+			return !orbit.zx.empty() && orbit.nBits >= nBits
+				&& x.hi == orbit.x.hi && x.lo == orbit.x.lo && y.hi == orbit.y.hi && y.lo == orbit.y.lo;
+		};
+
+		double dx, dy;
+		bool bNucleus = nucleus.nPeriod > 0 && InView(nucleus.x, nucleus.y, dx, dy);
+		bool bPrevious = !bNucleus && IsOrbitPoint(orbit.x, orbit.y) && InView(orbit.x, orbit.y, dx, dy);
+		if (!bNucleus && !bPrevious)
+		{
+			// The period is searched in the disk around the center that covers the view
+			Nucleus found;
+			double radius = 0.5 * std::hypot(ScreenWidth() * xStep, ScreenHeight() * yStep);
+			FindNucleus(referenceX, referenceY, FindPeriod(referenceX, referenceY, radius), found);
+			if (found.nPeriod > 0 && InView(found.x, found.y, dx, dy))
+			{
+				nucleus = found;
+				bNucleus = true;
+			}
+		}
+		if (bNucleus || bPrevious)
+		{
+			referenceX = bNucleus ? nucleus.x : orbit.x;
+			referenceY = bNucleus ? nucleus.y : orbit.y;
+			dxTopLeft = dx;
+			dyTopLeft = dy;
+		}
+
+		auto tp1 = std::chrono::high_resolution_clock::now();
+
+		if (IsOrbitPoint(referenceX, referenceY))
+			orbit.sOrigin = "reused";
+		else if (LoadReferenceOrbit(referenceX, referenceY, nBits))
+			orbit.sOrigin = "from the cache";
+		else
+		{
+			CalculateReferenceOrbit(referenceX, referenceY, nBits);
+			orbit.sOrigin = "calculated";
+		}
+
+		if ((int)orbit.zx.size() <= maxCount && !orbit.bEscaped)
+		{
+			ExtendReferenceOrbit();
+			orbit.sOrigin += ", extended";
+		}
+
+		std::chrono::duration<double> calculationTime = std::chrono::high_resolution_clock::now() - tp1;
+		if (calculationTime.count() > fOrbitCacheMinSeconds)
+			SaveReferenceOrbit();
+
+		orbit.bNucleus = bNucleus;
+		orbit.dxColumns.resize(ScreenWidth());
+		double dxColumn = dxTopLeft;
+		for (int x = 0; x < ScreenWidth(); x++)
+		{
+			orbit.dxColumns[x] = dxColumn;
+			dxColumn += xStep;
+		}
+		orbit.dyRows.resize(ScreenHeight());
+		for (int y = 0; y < ScreenHeight(); y++)
+			orbit.dyRows[y] = dyTopLeft + y * yStep;
+		orbit.dcMax = std::hypot(
+			std::max(std::abs(dxTopLeft), std::abs(dxTopLeft + (ScreenWidth() - 1) * xStep)),
+			std::max(std::abs(dyTopLeft), std::abs(dyTopLeft + (ScreenHeight() - 1) * yStep)));
+		bReferenceOrbitUsed = true;
+	}
+
+	// Find the nucleus of the minibrot nearest to the mouse, for use as the reference of perturbation
+	void FindNucleusAtMouse()
+	{
+		const Vector2T<DoubleDouble>& worldTopLeft = tv.GetPreciseWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double xStep = 1.0 / worldScale.x;
+		double yStep = 1.0 / worldScale.y;
+
+		auto mousePos = GetMousePos();
+		DoubleDouble x = worldTopLeft.x + DoubleDouble(xStep) * (double)mousePos.x;
+		DoubleDouble y = worldTopLeft.y + DoubleDouble(yStep) * (double)mousePos.y;
+
+		double radius = nNucleusSearchPixels * std::min(std::abs(xStep), std::abs(yStep));
+		FindNucleus(x, y, FindPeriod(x, y, radius), nucleus);
+	}
+
+	// Perturbation, with the pixel rows given as the difference from the reference point at the center
+	void DrawOpenMPPerturbation()
+	{
+		PrepareReferenceOrbit();
+
+#pragma omp parallel
+#pragma omp for schedule(dynamic, 1) nowait
+		for (int y = 0; y < ScreenHeight(); y++)
+		{
+			DrawRowKernel(y, referenceOrbit.dxColumns.data(), referenceOrbit.dyRows[y], &PgeMandelbrotParallel::MandelbrotRowPerturbation);
+		}
+	}
+
+	// The same schedulers as above, but with the SIMD row kernel selected at startup
+
+	void DrawOpenMPSIMD()
+	{
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowSIMD);
+
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+#pragma omp parallel
+#pragma omp for schedule(dynamic, 1) nowait
+		for (int y = 0; y < ScreenHeight(); y++)
+		{
+			DrawRow(y, worldTopLeft.y + y * yStep, &PgeMandelbrotParallel::MandelbrotRowSIMD);
+		}
+	}
+
+	void DrawCpp17ForEachSIMD()
+	{
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowSIMD);
+
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+		std::vector<size_t> indices(ScreenHeight());
+		std::iota(indices.begin(), indices.end(), 0);
+
+		std::for_each(std::execution::par, indices.begin(), indices.end(),
+			[&](size_t y)
+			{
+				DrawRow((int)y, worldTopLeft.y + y * yStep, &PgeMandelbrotParallel::MandelbrotRowSIMD);
+			}
+		);
+	}
+
+#if defined(_MSC_VER)
+	void DrawPPLParallelForSIMD()
+	{
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowSIMD);
+
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+		concurrency::parallel_for(0, ScreenHeight(),
+			[&](size_t y)
+			{
+				DrawRow((int)y, worldTopLeft.y + y * yStep, &PgeMandelbrotParallel::MandelbrotRowSIMD);
+			}
+		);
+	}
+#endif
+
+#if defined(__GNUG__) || defined(USE_TBB_WITH_MSC)
+	void DrawTBBParallelForRows(MandelbrotRowFunction PgeMandelbrotParallel::* pRow)
+	{
+		SetFrameRowKernel(pRow);
+
+		olc::vd2d worldTopLeft = tv.GetWorldOffset();
+		olc::vd2d worldScale = tv.GetWorldScale();
+
+		double yStep = 1.0 / worldScale.y;
+
+		tbb::parallel_for(0, ScreenHeight(),
+			[&](size_t y)
+			{
+				DrawRow((int)y, worldTopLeft.y + y * yStep, pRow);
+			}
+		);
+	}
+
+	void DrawTBBParallelForSIMD()
+	{
+		DrawTBBParallelForRows(&PgeMandelbrotParallel::MandelbrotRowSIMD);
+	}
+
+#if defined(USE_X86_SIMD)
+	// The AVX-512 kernels explicitly, for benchmarking against DrawTBBParallelFor
+	// On CPUs without AVX-512 these fall back to the kernel selected at startup,
+	// and for other formulas than Mandelbrot to the portable kernels
+	void DrawTBBParallelForAVX512()
+	{
+		if (!Formulas[nCurrentFormulaIndex].bMandelbrot)
+			DrawTBBParallelForRows(CurrentRowKernel(RowKernel::Portable));
+		else
+			DrawTBBParallelForRows(cpuFeatures.bAVX512 ? &PgeMandelbrotParallel::MandelbrotRowAVX512 : pMandelbrotRow);
+	}
+
+	void DrawTBBParallelForAVX512Float()
+	{
+		if (!Formulas[nCurrentFormulaIndex].bMandelbrot)
+			DrawTBBParallelForRows(CurrentRowKernel(RowKernel::PortableFloat));
+		else
+			DrawTBBParallelForRows(cpuFeatures.bAVX512 ? &PgeMandelbrotParallel::MandelbrotRowAVX512Float : pMandelbrotRowFloat);
+	}
+#endif
+
+	// The 128 bit fixed point kernel at any zoom, giving the same image with every compiler
+	void DrawTBBParallelForFixed128()
+	{
+		pFrameRowDoubleDouble = Formulas[nCurrentFormulaIndex].pRowFixed128;
+
+		tbb::parallel_for(0, ScreenHeight(),
+			[&](size_t y)
+			{
+				DrawRowDoubleDouble((int)y, Formulas[nCurrentFormulaIndex].pRowFixed128);
+			}
+		);
+	}
+
+	// Perturbation with oneTBB, see DrawOpenMPPerturbation
+	void DrawTBBParallelForPerturbation()
+	{
+		PrepareReferenceOrbit();
+
+		tbb::parallel_for(0, ScreenHeight(),
+			[&](size_t y)
+			{
+				DrawRowKernel((int)y, referenceOrbit.dxColumns.data(), referenceOrbit.dyRows[y], &PgeMandelbrotParallel::MandelbrotRowPerturbation);
+			}
+		);
+	}
+
+	// Perturbation with series approximation, in tiles scheduled by oneTBB
+	void DrawTBBParallelForSeries()
+	{
+		PrepareReferenceOrbit();
+		CalculateSeriesCoefficients();
+
+		int nTilesX = (ScreenWidth() + nSeriesTileSize - 1) / nSeriesTileSize;
+		int nTilesY = (ScreenHeight() + nSeriesTileSize - 1) / nSeriesTileSize;
+
+		tbb::parallel_for(0, nTilesX * nTilesY,
+			[&](int tile)
+			{
+				int tileX = (tile % nTilesX) * nSeriesTileSize;
+				int tileY = (tile / nTilesX) * nSeriesTileSize;
+				int width = std::min(nSeriesTileSize, ScreenWidth() - tileX);
+				int height = std::min(nSeriesTileSize, ScreenHeight() - tileY);
+				DrawTileSeries(tileX, tileY, width, height);
+			}
+		);
+	}
+
+	// Perturbation with the BLA table, with oneTBB
+	void DrawTBBParallelForBla()
+	{
+		PrepareReferenceOrbit();
+		CalculateBlaTable(referenceOrbit.dcMax);
+
+		tbb::parallel_for(0, ScreenHeight(),
+			[&](size_t y)
+			{
+				DrawRowKernel((int)y, referenceOrbit.dxColumns.data(), referenceOrbit.dyRows[y], &PgeMandelbrotParallel::MandelbrotRowBla);
+			}
+		);
+	}
+
+	// Perturbation with the BLA table and rebasing of glitched pixels, with oneTBB
+	void DrawTBBParallelForRebasing()
+	{
+		PrepareReferenceOrbit();
+		CalculateBlaTable(referenceOrbit.dcMax);
+
+		tbb::parallel_for(0, ScreenHeight(),
+			[&](size_t y)
+			{
+				DrawRowKernel((int)y, referenceOrbit.dxColumns.data(), referenceOrbit.dyRows[y], &PgeMandelbrotParallel::MandelbrotRowRebasing);
+			}
+		);
+	}
+
+	// The interleaved scalar kernel, a speedup without SIMD for any platform
+	void DrawTBBParallelForInterleaved()
 	{
-		olc::Key commandKey;		// Key to select this calculation method
-		std::string commandKeyName;	// Name of Key for display
-		std::string description;	// Description of this draw function
-		DrawFunction PgeMandelbrotParallel::* pDrawFunction;
-									// Pointer to the draw function as a member method
-	};
+		DrawTBBParallelForRows(CurrentRowKernel(RowKernel::Interleaved));
+	}
 
-	// Vector of information for the draw functions to be investigated
-	// Initialized at the bottom of this file
-	static std::vector<DrawFunctionDescription> DrawFunctions;
+	// Mariani-Silver subdivision
+	// The border of a rectangle is calculated, and if all of it has the same count, the inside is filled
+	// with that count. This is exact for the interior of the Mandelbrot set, which is connected, and a very
+	// good guess for the bands of the exterior. Otherwise the rectangle is split in two by calculating the line
+	// between the halves, and the halves are subdivided as parallel oneTBB tasks
+	static constexpr int nSubdivisionMinSize = 10;		// Smaller rectangles are calculated pixel by pixel
 
-	// Index of the currently selected draw function
-	size_t nCurrentDrawFunctionIndex = 0;
+	// The rectangle is from (x0, y0) to (x1, y1) inclusive, and its border has been calculated
+	void SubdivideRectangle(int x0, int y0, int x1, int y1)
+	{
+		int count = FrameCount(x0, y0);
+		bool bUniform = true;
+		for (int x = x0; x <= x1 && bUniform; x++)
+			bUniform = FrameCount(x, y0) == count && FrameCount(x, y1) == count;
+		for (int y = y0; y <= y1 && bUniform; y++)
+			bUniform = FrameCount(x0, y) == count && FrameCount(x1, y) == count;
+
+		if (bUniform)
+		{
+			for (int y = y0 + 1; y < y1; y++)
+				for (int x = x0 + 1; x < x1; x++)
+					FillPixel(x, y, count);
+			nFilledPixels += (int64_t)std::max(x1 - x0 - 1, 0) * std::max(y1 - y0 - 1, 0);
+			return;
+		}
 
-	// The Mandelbrot algorithm
-	int32_t maxCount;  // Max count for the iterative function
-	const float pi = std::acos(-1.0F);
-	const float pithird = pi / 3;
+		if (x1 - x0 <= nSubdivisionMinSize || y1 - y0 <= nSubdivisionMinSize)
+		{
+			for (int y = y0 + 1; y < y1; y++)
+				CalculateSegment(x0 + 1, y, x1 - x0 - 1);
+			return;
+		}
 
+		// Rows are calculated with the SIMD kernel, but columns pixel by pixel, so rectangles are split across rows
+		// unless they are much wider than high
+		if (x1 - x0 > 4 * (y1 - y0))
+		{
+			int xm = (x0 + x1) / 2;
+			for (int y = y0 + 1; y < y1; y++)
+				CalculateSegment(xm, y, 1);
+			tbb::parallel_invoke(
+				[&] { SubdivideRectangle(x0, y0, xm, y1); },
+				[&] { SubdivideRectangle(xm, y0, x1, y1); });
+		}
+		else
+		{
+			int ym = (y0 + y1) / 2;
+			CalculateSegment(x0 + 1, ym, x1 - x0 - 1);
+			tbb::parallel_invoke(
+				[&] { SubdivideRectangle(x0, y0, x1, ym); },
+				[&] { SubdivideRectangle(x0, ym, x1, y1); });
+		}
+	}
 
-	int MandelbrotCount(double x, double y)
+	void DrawTBBMarianiSilver()
 	{
-		double zx = x;
-		double zy = y;
-		double zx2 = zx * zx;
-		double zy2 = zy * zy;
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowSIMD);
 
-		int count = 0;
+		int w = ScreenWidth();
+		int h = ScreenHeight();
+		frameCounts.assign((size_t)w * h, 0);
 
-		while (count < maxCount && zx2 + zy2 <= 4.0)
+		CalculateSegment(0, 0, w);
+		CalculateSegment(0, h - 1, w);
+		for (int y = 1; y < h - 1; y++)
 		{
-			zy = zy * zx * 2 + y;
-			zx = zx2 - zy2 + x;
-			zx2 = zx * zx;
-			zy2 = zy * zy;
-
-			count++;
+			CalculateSegment(0, y, 1);
+			CalculateSegment(w - 1, y, 1);
 		}
 
-		return count;
+		SubdivideRectangle(0, 0, w - 1, h - 1);
 	}
 
-	void DrawSingleThread()
+	// Boundary tracing
+	// Starting from the border of a tile, each calculated pixel with a neighbour of another count queues its
+	// neighbours, so the calculation follows the boundaries between regions of equal count, and never enters them.
+	// The pixels left inside are then filled from their left neighbour. As the Mandelbrot set is connected,
+	// this is exact for the interior, which is where the cost is at high maxCount
+	// The tiles are traced independently, as parallel oneTBB tasks, each seeded by its own border
+	// A pixel is calculated together with the pixels to its right, up to a vector of the widest SIMD kernel,
+	// as that costs about the same. Those have exact counts, but are not part of the trace until it loads them
+	static constexpr int nBoundaryTraceTileSize = 64;
+	static constexpr int nBoundaryTraceRun = 8;
+
+	enum PixelState : uint8_t { Calculated = 1, Loaded = 2, Queued = 4 };
+	std::vector<uint8_t> frameStates;	// PixelState bits of each pixel in the current frame
+
+	void TraceTile(int x0, int y0, int x1, int y1)
 	{
-		// Current area for calculation must be calculated
-		olc::vd2d worldTopLeft = tv.GetWorldOffset();
-		olc::vd2d worldScale = tv.GetWorldScale();
+		int w = ScreenWidth();
+		std::vector<int> queue;
 
-		double xStep = 1.0 / worldScale.x;
-		double yStep = 1.0 / worldScale.y;
+		auto Queue = [&](int x, int y)
+			{
+				uint8_t& state = frameStates[(size_t)y * w + x];
+				if (!(state & Queued))
+				{
+					state |= Queued;
+					queue.push_back(y * w + x);
+				}
+			};
 
-		// Calculate and draw line by line
-		double worldY = worldTopLeft.y;
-		for (int y = 0; y < ScreenHeight(); y++)
-		{
-			double worldX = worldTopLeft.x;
-			for (int x = 0; x < ScreenWidth(); x++)
+		auto Load = [&](int x, int y)
 			{
-				int count = MandelbrotCount(worldX, worldY);
-				olc::Pixel currPix;
-				if (count >= maxCount)
-					currPix = olc::BLACK;
-				else
+				uint8_t* pStates = &frameStates[(size_t)y * w];
+				if (!(pStates[x] & Calculated))
 				{
-					float angle = 2 * pi * count / maxCount;
-					// Palette based on @Eriksonn's calculation, see my post and OneLoneCoder Discord channel
-					currPix = olc::PixelF(0.5f * sin(angle) + 0.5f, 0.5f * sin(angle + 2 * pithird) + 0.5f, 0.5f * sin(angle + 4 * pithird) + 0.5f);
+					int nPixels = 1;
+					while (nPixels < nBoundaryTraceRun && x + nPixels < x1 && !(pStates[x + nPixels] & Calculated))
+						nPixels++;
+					CalculateSegment(x, y, nPixels);
+					for (int i = 0; i < nPixels; i++)
+						pStates[x + i] |= Calculated;
 				}
+				pStates[x] |= Loaded;
+				return FrameCount(x, y);
+			};
+
+		// The rows of the border with the SIMD kernel, the columns pixel by pixel
+		CalculateSegment(x0, y0, x1 - x0);
+		CalculateSegment(x0, y1 - 1, x1 - x0);
+		for (int x = x0; x < x1; x++)
+		{
+			frameStates[(size_t)y0 * w + x] |= Calculated | Loaded;
+			frameStates[(size_t)(y1 - 1) * w + x] |= Calculated | Loaded;
+			Queue(x, y0);
+			Queue(x, y1 - 1);
+		}
+		for (int y = y0 + 1; y < y1 - 1; y++)
+		{
+			Load(x0, y);
+			Load(x1 - 1, y);
+			Queue(x0, y);
+			Queue(x1 - 1, y);
+		}
+
+		while (!queue.empty())
+		{
+			int x = queue.back() % w;
+			int y = queue.back() / w;
+			queue.pop_back();
+
+			int count = Load(x, y);
+			bool bLeft = x > x0, bRight = x < x1 - 1, bUp = y > y0, bDown = y < y1 - 1;
+			bool l = bLeft && Load(x - 1, y) != count;
+			bool r = bRight && Load(x + 1, y) != count;
+			bool u = bUp && Load(x, y - 1) != count;
+			bool d = bDown && Load(x, y + 1) != count;
+
+			// A boundary pixel queues its neighbours, and the diagonal ones next to a boundary,
+			// so a boundary that only touches diagonally is followed too
+			if (l) Queue(x - 1, y);
+			if (r) Queue(x + 1, y);
+			if (u) Queue(x, y - 1);
+			if (d) Queue(x, y + 1);
+			if (bUp && bLeft && (u || l)) Queue(x - 1, y - 1);
+			if (bUp && bRight && (u || r)) Queue(x + 1, y - 1);
+			if (bDown && bLeft && (d || l)) Queue(x - 1, y + 1);
+			if (bDown && bRight && (d || r)) Queue(x + 1, y + 1);
+		}
 
-				Draw(x, y, currPix);
-				worldX += xStep;
+		// Every pixel not loaded is inside a boundary of equal counts, and is filled with the count of the nearest
+		// loaded pixel to the left, the left border of the tile is loaded. Pixels only calculated keep their counts
+		int64_t nFilled = 0;
+		for (int y = y0 + 1; y < y1 - 1; y++)
+		{
+			int count = FrameCount(x0, y);
+			for (int x = x0 + 1; x < x1 - 1; x++)
+			{
+				uint8_t state = frameStates[(size_t)y * w + x];
+				if (state & Loaded)
+					count = FrameCount(x, y);
+				else if (!(state & Calculated))
+				{
+					FillPixel(x, y, count);
+					nFilled++;
+				}
 			}
-			worldY += yStep;
 		}
+		nFilledPixels += nFilled;
 	}
 
-	void DrawOpenMP()
+	void DrawTBBBoundaryTrace()
 	{
-		// Current area for calculation must be calculated
-		olc::vd2d worldTopLeft = tv.GetWorldOffset();
-		olc::vd2d worldScale = tv.GetWorldScale();
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowSIMD);
 
-		double xStep = 1.0 / worldScale.x;
-		double yStep = 1.0 / worldScale.y;
+		int w = ScreenWidth();
+		int h = ScreenHeight();
+		frameCounts.assign((size_t)w * h, 0);
+		frameStates.assign((size_t)w * h, 0);
 
-		// Calculate and draw line by line
-		// Using OpenMP
-		// There are no dependencies between each y-iteration for the Mandelbrot set
-		// but ensure that no dependencies are created, e.g. reused variable
-		// schedule(dynamic) ensures this non-dependency is used, scheduling the lines as fast as possible
-		// nowait is probably unnecessary in this case
-#pragma omp parallel
-#pragma omp for schedule(dynamic, 1) nowait
-		for (int y = 0; y < ScreenHeight(); y++)
-		{
-			// This must have a separate copy for each possible thread
-			double worldY = worldTopLeft.y + y * yStep;
-			double worldX = worldTopLeft.x;
-			for (int x = 0; x < ScreenWidth(); x++)
-			{
-				int count = MandelbrotCount(worldX, worldY);
-				olc::Pixel currPix;
-				if (count >= maxCount)
-					currPix = olc::BLACK;
-				else
-				{
-					float angle = 2 * pi * count / maxCount;
-					// Palette based on @Eriksonn's calculation, see my post and OneLoneCoder Discord channel
-					currPix = olc::PixelF(0.5f * sin(angle) + 0.5f, 0.5f * sin(angle + 2 * pithird) + 0.5f, 0.5f * sin(angle + 4 * pithird) + 0.5f);
-				}
+		int nTilesX = (w + nBoundaryTraceTileSize - 1) / nBoundaryTraceTileSize;
+		int nTilesY = (h + nBoundaryTraceTileSize - 1) / nBoundaryTraceTileSize;
 
-				Draw(x, y, currPix);
-				worldX += xStep;
+		tbb::parallel_for(0, nTilesX * nTilesY,
+			[&](int tile)
+			{
+				int tileX = (tile % nTilesX) * nBoundaryTraceTileSize;
+				int tileY = (tile / nTilesX) * nBoundaryTraceTileSize;
+				TraceTile(tileX, tileY, std::min(tileX + nBoundaryTraceTileSize, w), std::min(tileY + nBoundaryTraceTileSize, h));
 			}
-		}
+		);
 	}
 
-	void DrawCpp17ForEach()
+	// Solid guessing
+	// As in Fractint, the counts are first calculated on a grid of every 16th pixel. A block whose corners
+	// have the same count is guessed to have it everywhere, and a block whose corners differ is split in four
+	// by calculating the midpoints of its edges and its center. Unlike Mariani-Silver and boundary tracing,
+	// a guess can miss details between the samples, so at verification level L, the corners of a block must
+	// also agree on the blocks L splits further down before it is guessed, and each level halves the size
+	// of the details that can be missed
+	// Each block of the grid is a tile with its own quadtree and its own samples, so the tiles are
+	// calculated as parallel oneTBB tasks without sharing any sample
+	static constexpr int nGuessingStep = 16;
+
+	std::vector<int> guessingGrid;	// The counts on the grid, the corners of all the tiles, row by row
+
+	struct GuessingTile
 	{
-		// Current area for calculation must be calculated
-		olc::vd2d worldTopLeft = tv.GetWorldOffset();
-		olc::vd2d worldScale = tv.GetWorldScale();
+		int counts[nGuessingStep + 1][nGuessingStep + 1];
+		bool bCalculated[nGuessingStep + 1][nGuessingStep + 1] = {};
+	};
 
-		double xStep = 1.0 / worldScale.x;
-		double yStep = 1.0 / worldScale.y;
+	struct GuessingBlock
+	{
+		int x, y;
+		int nVerify;	// The levels down the corners must still agree before the block is guessed
+	};
 
-		// Calculate and draw line by line
-		// Using C++17 for_each algorithm with parallel execution
-		// There are no dependencies between each y-iteration for the Mandelbrot set
-		// but ensure that no dependencies are created, e.g. reused variable
+	// The quadtree of a tile is split a level at a time, so the new samples of each row of a level
+	// are calculated together, with the SIMD kernel stepping over the blocks
+	void GuessTile(GuessingTile& tile, int tileX, int tileY)
+	{
+		std::vector<GuessingBlock> blocks{ { 0, 0, nGuessingVerification } };
+		std::vector<GuessingBlock> splitBlocks;
 
-		// Create a vector of indices, this is how it is done in standard C++ pre C++20
-		// For C++20 and later, a iota view range may be possible (TBD)
-		std::vector<size_t> indices(ScreenHeight());
-		std::iota(indices.begin(), indices.end(), 0);
+		for (int s = nGuessingStep; s > 1 && !blocks.empty(); s /= 2)
+		{
+			int h = s / 2;
+			bool bNeeded[nGuessingStep + 1][nGuessingStep + 1] = {};
+			splitBlocks.clear();
 
-		// Use the for_each algorithm with a request for parallel execution
-		// A runtime scheduler will try to use all the cores
-		std::for_each(std::execution::par, indices.begin(), indices.end(),
-			[&](size_t y)
+			for (const GuessingBlock& block : blocks)
 			{
-				// This must have a separate copy for each possible thread
-				double worldY = worldTopLeft.y + y * yStep;
-				double worldX = worldTopLeft.x;
-				for (int x = 0; x < ScreenWidth(); x++)
+				int x = block.x;
+				int y = block.y;
+				int count = tile.counts[y][x];
+				bool bAgree = tile.counts[y][x + s] == count && tile.counts[y + s][x] == count && tile.counts[y + s][x + s] == count;
+				if (bAgree && block.nVerify == 0)
+				{
+					// Samples calculated inside keep their counts, and samples calculated later replace the guess
+					for (int j = y; j < y + s; j++)
+						for (int i = x; i < x + s; i++)
+							if (!tile.bCalculated[j][i])
+								tile.counts[j][i] = count;
+					continue;
+				}
+
+				bNeeded[y][x + h] = bNeeded[y + h][x] = bNeeded[y + h][x + h] = bNeeded[y + h][x + s] = bNeeded[y + s][x + h] = true;
+
+				// Agreeing corners are verified on the next level down, and differing corners start the verification over
+				int nNextVerify = bAgree ? block.nVerify - 1 : nGuessingVerification;
+				splitBlocks.push_back({ x, y, nNextVerify });
+				splitBlocks.push_back({ x + h, y, nNextVerify });
+				splitBlocks.push_back({ x, y + h, nNextVerify });
+				splitBlocks.push_back({ x + h, y + h, nNextVerify });
+			}
+
+			// Each run of needed samples in a row in one call of the row kernel
+			for (int j = 0; j <= nGuessingStep; j += h)
+			{
+				int i = 0;
+				while (i <= nGuessingStep)
 				{
-					int count = MandelbrotCount(worldX, worldY);
-					olc::Pixel currPix;
-					if (count >= maxCount)
-						currPix = olc::BLACK;
-					else
+					int nPixels = 0;
+					while (i + nPixels * h <= nGuessingStep && bNeeded[j][i + nPixels * h] && !tile.bCalculated[j][i + nPixels * h])
+						nPixels++;
+					if (nPixels == 0)
 					{
-						float angle = 2 * pi * count / maxCount;
-						// Palette based on @Eriksonn's calculation, see my post and OneLoneCoder Discord channel
-						currPix = olc::PixelF(0.5f * sin(angle) + 0.5f, 0.5f * sin(angle + 2 * pithird) + 0.5f, 0.5f * sin(angle + 4 * pithird) + 0.5f);
+						i += h;
+						continue;
 					}
 
-					Draw(x, y, currPix);
-					worldX += xStep;
+					int counts[nGuessingStep + 1];
+					CalculateCounts(tileX + i, tileY + j, h, nPixels, counts);
+					for (int k = 0; k < nPixels; k++)
+					{
+						tile.counts[j][i + k * h] = counts[k];
+						tile.bCalculated[j][i + k * h] = true;
+					}
+					i += nPixels * h;
 				}
 			}
-		);
+
+			std::swap(blocks, splitBlocks);
+		}
 	}
 
-#if defined(_MSC_VER)
-	void DrawPPLParallelFor()
+	void DrawTBBSolidGuessing()
 	{
-		// Current area for calculation must be calculated
-		olc::vd2d worldTopLeft = tv.GetWorldOffset();
-		olc::vd2d worldScale = tv.GetWorldScale();
-
-		double xStep = 1.0 / worldScale.x;
-		double yStep = 1.0 / worldScale.y;
-
-		// Calculate and draw line by line
-		// Using Microsoft concurrency library PPL parallel_for
-		// There are no dependencies between each y-iteration for the Mandelbrot set
-		// but ensure that no dependencies are created, e.g. reused variable
+		SetFrameRowKernel(&PgeMandelbrotParallel::MandelbrotRowSIMD);
+
+		int w = ScreenWidth();
+		int h = ScreenHeight();
+		int nTilesX = (w + nGuessingStep - 1) / nGuessingStep;
+		int nTilesY = (h + nGuessingStep - 1) / nGuessingStep;
+		int nGridWidth = nTilesX + 1;
+
+		// The grid rows with the SIMD kernel stepping over the tiles, the last row and column can be outside the screen
+		guessingGrid.assign((size_t)nGridWidth * (nTilesY + 1), 0);
+		tbb::parallel_for(0, nTilesY + 1,
+			[&](int j)
+			{
+				CalculateCounts(0, j * nGuessingStep, nGuessingStep, nGridWidth, &guessingGrid[(size_t)j * nGridWidth]);
+			}
+		);
 
-		// Use the parallel_for algorithm
-		// A runtime scheduler will try to use all the cores
-		concurrency::parallel_for(0, ScreenHeight(),
-			[&](size_t y)
+		tbb::parallel_for(0, nTilesX * nTilesY,
+			[&](int t)
 			{
-				// This must have a separate copy for each possible thread
-				double worldY = worldTopLeft.y + y * yStep;
-				double worldX = worldTopLeft.x;
-				for (int x = 0; x < ScreenWidth(); x++)
-				{
-					int count = MandelbrotCount(worldX, worldY);
-					olc::Pixel currPix;
-					if (count >= maxCount)
-						currPix = olc::BLACK;
-					else
+				int tx = t % nTilesX;
+				int ty = t / nTilesX;
+				int tileX = tx * nGuessingStep;
+				int tileY = ty * nGuessingStep;
+
+				GuessingTile tile;
+				for (int j = 0; j <= 1; j++)
+					for (int i = 0; i <= 1; i++)
 					{
-						float angle = 2 * pi * count / maxCount;
-						// Palette based on @Eriksonn's calculation, see my post and OneLoneCoder Discord channel
-						currPix = olc::PixelF(0.5f * sin(angle) + 0.5f, 0.5f * sin(angle + 2 * pithird) + 0.5f, 0.5f * sin(angle + 4 * pithird) + 0.5f);
+						tile.counts[j * nGuessingStep][i * nGuessingStep] = guessingGrid[(size_t)(ty + j) * nGridWidth + tx + i];
+						tile.bCalculated[j * nGuessingStep][i * nGuessingStep] = true;
 					}
 
-					Draw(x, y, currPix);
-					worldX += xStep;
-				}
+				GuessTile(tile, tileX, tileY);
+
+				// The right column and bottom row are drawn by the next tiles
+				int64_t nGuessed = 0;
+				for (int j = 0; j < nGuessingStep && tileY + j < h; j++)
+					for (int i = 0; i < nGuessingStep && tileX + i < w; i++)
+					{
+						Draw(tileX + i, tileY + j, CountToPixel(tile.counts[j][i]));
+						nGuessed += tile.bCalculated[j][i] ? 0 : 1;
+					}
+				nFilledPixels += nGuessed;
 			}
 		);
 	}
-#endif
-
-	// The following demands installation of OneTBB for Windows/MSVC to work with MSVC _MSC_VER
 
-#if defined(__GNUG__) || defined(USE_TBB_WITH_MSC)
-	void DrawTBBParallelFor()
+	// Progressive refinement
+	// A slow frame is spread over several frames, so the view stays responsive while it fills in.
+	// The first pass calculates one sample per 16x16 block, and each later pass halves the block size,
+	// calculating only the samples that are new at it. Each sample is drawn as its whole block,
+	// so every frame shows the finest samples so far. A pass is calculated in chunks of rows while
+	// the frame has time left, and continues in the next frame, until the view changes
+	static constexpr int nProgressiveFirstStep = 16;
+	static constexpr double fProgressiveFrameBudget = 0.012;	// Seconds of calculation per frame, the rest of a 60 fps frame is for drawing
+
+	FrameView progressiveView;					// The view of the samples, any change starts over from the first pass
+	std::vector<olc::Pixel> progressivePixels;	// Each sample drawn as its block
+	int nProgressiveStep = 0;					// The block size of the current pass, 0 when all passes are done
+	int nProgressiveRow = 0;					// The next row of the current pass
+
+	// Calculate the samples of row y new at block size nStep, with the SIMD kernel stepping over the blocks
+	// The rows of the previous pass only have new samples between the old ones
+	void CalculateProgressiveRow(int y, int nStep)
 	{
-		// Current area for calculation must be calculated
-		olc::vd2d worldTopLeft = tv.GetWorldOffset();
-		olc::vd2d worldScale = tv.GetWorldScale();
+		int w = ScreenWidth();
+		bool bNewRow = nStep == nProgressiveFirstStep || y % (2 * nStep) != 0;
+		int x0 = bNewRow ? 0 : nStep;
+		int nStride = bNewRow ? nStep : 2 * nStep;
+		int nPixels = (w - x0 + nStride - 1) / nStride;
+		if (nPixels <= 0)
+			return;
+
+		std::vector<int> counts(nPixels);
+		CalculateCounts(x0, y, nStride, nPixels, counts.data());
+
+		int yEnd = std::min(y + nStep, ScreenHeight());
+		for (int i = 0; i < nPixels; i++)
+		{
+			int x = x0 + i * nStride;
+			olc::Pixel pixel = CountToPixel(counts[i]);
+			for (int yBlock = y; yBlock < yEnd; yBlock++)
+			{
+				auto row = progressivePixels.begin() + (size_t)yBlock * w;
+				std::fill(row + x, row + std::min(x + nStep, w), pixel);
+			}
+		}
+	}
 
-		double xStep = 1.0 / worldScale.x;
-		double yStep = 1.0 / worldScale.y;
+	void DrawTBBProgressive()
+	{
+		auto tpStart = std::chrono::high_resolution_clock::now();
+		int w = ScreenWidth();
+		int h = ScreenHeight();
 
-		// Calculate and draw line by line
-		// Using Microsoft concurrency library PPL parallel_for
-		// There are no dependencies between each y-iteration for the Mandelbrot set
-		// but ensure that no dependencies are created, e.g. reused variable
+		FrameView view = CurrentFrameView();
+		if (!(view == progressiveView) || progressivePixels.size() != (size_t)w * h)
+		{
+			progressiveView = view;
+			progressivePixels.assign((size_t)w * h, olc::BLACK);
+			nProgressiveStep = nProgressiveFirstStep;
+			nProgressiveRow = 0;
+		}
 
-		// Use the parallel_for algorithm
-		// A runtime scheduler will try to use all the cores
-		tbb::parallel_for(0, ScreenHeight(),
-			[&](size_t y)
-			{
-				// This must have a separate copy for each possible thread
-				double worldY = worldTopLeft.y + y * yStep;
-				double worldX = worldTopLeft.x;
-				for (int x = 0; x < ScreenWidth(); x++)
+		// A chunk has two rows per thread, and at least one chunk is calculated in each frame
+		int nChunkRows = 2 * tbb::this_task_arena::max_concurrency();
+		bool bFirstChunk = true;
+		while (nProgressiveStep > 0 &&
+			(bFirstChunk || std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - tpStart).count() < fProgressiveFrameBudget))
+		{
+			int nStep = nProgressiveStep;
+			int yStart = nProgressiveRow;
+			int nRows = std::min((h - yStart + nStep - 1) / nStep, nChunkRows);
+			tbb::parallel_for(0, nRows,
+				[&](int i)
 				{
-					int count = MandelbrotCount(worldX, worldY);
-					olc::Pixel currPix;
-					if (count >= maxCount)
-						currPix = olc::BLACK;
-					else
-					{
-						float angle = 2 * pi * count / maxCount;
-						// Palette based on @Eriksonn's calculation, see my post and OneLoneCoder Discord channel
-						currPix = olc::PixelF(0.5f * sin(angle) + 0.5f, 0.5f * sin(angle + 2 * pithird) + 0.5f, 0.5f * sin(angle + 4 * pithird) + 0.5f);
-					}
-
-					Draw(x, y, currPix);
-					worldX += xStep;
+					CalculateProgressiveRow(yStart + i * nStep, nStep);
 				}
+			);
+
+			nProgressiveRow += nRows * nStep;
+			if (nProgressiveRow >= h)
+			{
+				nProgressiveStep /= 2;
+				nProgressiveRow = 0;
 			}
-		);
+			bFirstChunk = false;
+		}
+
+		std::copy(progressivePixels.begin(), progressivePixels.end(), GetDrawTarget()->GetData());
+	}
+
+#if defined(USE_STD_SIMD)
+	// The std::simd kernel testing for escape once per block of iterations, in float where it is precise enough
+	template <RowKernel BlockedKernel, RowKernel BlockedKernelFloat>
+	void DrawTBBParallelForBlocked()
+	{
+		DrawTBBParallelForRows(CurrentRowKernel(bFloatPrecision ? BlockedKernelFloat : BlockedKernel));
 	}
 #endif
+#endif
 
 public:
 	bool OnUserCreate() override
@@ -342,6 +3348,8 @@ public:
 
 		maxCount = 256;
 
+		SelectMandelbrotRowKernel();
+
 		return true;
 	}
 
@@ -382,6 +3390,56 @@ public:
 				maxCount = 64;
 		}
 
+		// Periodicity check interval, doubled or halved down to 0 for no check
+		if (GetKey(olc::Key::PGUP).bPressed)
+		{
+			nPeriodicityCheckInterval = nPeriodicityCheckInterval == 0 ? 1 : std::min(nPeriodicityCheckInterval * 2, 1024);
+		}
+		else if (GetKey(olc::Key::PGDN).bPressed)
+		{
+			nPeriodicityCheckInterval /= 2;
+		}
+
+		// Toggle the automatic float precision
+		if (GetKey(olc::Key::P).bPressed)
+		{
+			bAutoFloat = !bAutoFloat;
+		}
+
+		// Find the nucleus of the nearest minibrot, used as the reference of the perturbation draw modes
+		if (GetKey(olc::Key::N).bPressed)
+		{
+			FindNucleusAtMouse();
+		}
+
+		// Cycle the verification level of solid guessing
+		if (GetKey(olc::Key::L).bPressed)
+		{
+			nGuessingVerification = (nGuessingVerification + 1) % (nGuessingMaxVerification + 1);
+		}
+
+		// Toggle the reuse of the last frame while panning
+		if (GetKey(olc::Key::D).bPressed)
+		{
+			bPanReuse = !bPanReuse;
+		}
+
+		// Check the next frame of the current draw mode against full rows of the SIMD kernel
+		if (GetKey(olc::Key::C).bPressed)
+		{
+			bCheckRequested = true;
+		}
+
+		// Select the iteration formula
+		for (size_t i = 0; i < Formulas.size(); i++)
+		{
+			if (GetKey(Formulas[i].commandKey).bPressed)
+			{
+				nCurrentFormulaIndex = i;
+				break;
+			}
+		}
+
 		// Determine overall algorithm
 		for (size_t i = 0; i < DrawFunctions.size(); i++)
 		{
@@ -398,16 +3456,61 @@ public:
 		// Clear, even if we redraw all pixels
 		Clear(olc::BLACK);
 
+		// Use the float kernels, if the zoom depth allows it, and the double-double kernels if double is not enough
+		bFloatPrecision = bAutoFloat && FloatPrecisionSufficient();
+		bDoubleDoublePrecision = !DoublePrecisionSufficient();
+		PrepareFrameColumns();
+
+		nPeriodicitySavedIterations = 0;
+		bReferenceOrbitUsed = false;
+		nSeriesSkippedIterations = 0;
+		nBlaSkippedIterations = 0;
+		nRebasedPixels = 0;
+		nReferenceEndPixels = 0;
+		nUncertainBlaPixels = 0;
+		nUncertainPixels = 0;
+		nFilledPixels = 0;
+
 		// START TIMING
 		auto tp1 = std::chrono::high_resolution_clock::now();
 
-		// Select the current draw function from the description table
-		(this->*DrawFunctions[nCurrentDrawFunctionIndex].pDrawFunction)();
+		// Select the current draw function from the description table, unless the last frame can be shifted by the pan
+		// A check always draws the frame
+		bPanReused = !bCheckRequested && DrawPannedFrame();
+		if (!bPanReused)
+		{
+			pFrameRow = nullptr;
+			pFrameRowDoubleDouble = nullptr;
+			(this->*CurrentDrawFunction())();
+		}
 
 		// STOP TIMING
 		auto tp2 = std::chrono::high_resolution_clock::now();
 		std::chrono::duration<double> elapsedTime = tp2 - tp1;
 
+		KeepFrame();
+
+		// The reference of a check is calculated after the timing, when the reference orbit of perturbation is known
+		if (bCheckRequested)
+		{
+			const olc::Pixel* pPixels = GetDrawTarget()->GetData();
+			std::string sMode = DrawFunctions[nCurrentDrawFunctionIndex].commandKeyName;
+			if (bReferenceOrbitUsed)
+			{
+				std::vector<olc::Pixel> checkPixels = CheckPerturbationReferencePixels();
+				sCheckResult = "Check of draw mode " + sMode + " against 128 bit fixed point (C): "
+					+ std::to_string(CountDifferentPixels(pPixels, checkPixels)) + " of " + std::to_string(checkPixels.size()) + " pixels differ, "
+					+ std::to_string(CountDifferentPixels(CheckPerturbationPixels().data(), checkPixels)) + " with F8";
+			}
+			else
+			{
+				std::vector<olc::Pixel> checkPixels = CheckReferencePixels();
+				sCheckResult = "Check of draw mode " + sMode + " against full rows of the SIMD kernel (C): "
+					+ std::to_string(CountDifferentPixels(pPixels, checkPixels)) + " of " + std::to_string(checkPixels.size()) + " pixels differ";
+			}
+			bCheckRequested = false;
+		}
+
 		// Text output will be overlayed on the graphics
 		uint32_t textScale = 1;
 		int32_t lineDistance = 10;
@@ -416,6 +3519,12 @@ public:
 		
 		int line = 0;
 
+#if defined(USE_STD_SIMD)
+		std::string sPortableKernel = "std::simd " + std::to_string(nPortableLanes) + " doubles";
+#else
+		std::string sPortableKernel = "Scalar";
+#endif
+
 		std::string compiler = "Unknown";
 #if defined(_MSC_VER)
 #if defined(__clang_version__)
@@ -436,15 +3545,58 @@ public:
 #endif
 
 		DrawString(0, line++ * lineDistance,
-			"Draw mode: " + DrawFunctions[nCurrentDrawFunctionIndex].commandKeyName + " " + DrawFunctions[nCurrentDrawFunctionIndex].description, olc::WHITE, textScale);
+			"Draw mode: " + DrawFunctions[nCurrentDrawFunctionIndex].commandKeyName + " " + DrawFunctions[nCurrentDrawFunctionIndex].description
+			+ (CurrentDrawFunction() != DrawFunctions[nCurrentDrawFunctionIndex].pDrawFunction ? " (Mandelbrot only, SIMD kernel for this formula)" : ""), olc::WHITE, textScale);
+		DrawString(0, line++ * lineDistance,
+			"Formula: " + Formulas[nCurrentFormulaIndex].commandKeyName + " " + Formulas[nCurrentFormulaIndex].description, olc::WHITE, textScale);
 		DrawString(0, line++ * lineDistance,
-			"Compiler: " + compiler, olc::WHITE, textScale);
+			"Compiler: " + compiler + "   SIMD kernel: " + sKernelISA + "   Portable kernel: " + sPortableKernel, olc::WHITE, textScale);
 		DrawString(0, line++ * lineDistance,
 			"Mouse x: " + std::to_string(worldMousePos.x) + ", y: " + std::to_string(worldMousePos.y), olc::WHITE, textScale);
 		DrawString(0, line++ * lineDistance,
 			"Calculation and DrawTime: " + std::to_string(elapsedTime.count()), olc::WHITE, textScale);
 		DrawString(0, line++ * lineDistance,
 			"maxCount: " + std::to_string(maxCount), olc::WHITE, textScale);
+		DrawString(0, line++ * lineDistance,
+			"Periodicity check interval: " + (nPeriodicityCheckInterval > 0 ? std::to_string(nPeriodicityCheckInterval) : std::string("off")) + " (PGUP/PGDN), saved iterations: " + std::to_string(nPeriodicitySavedIterations), olc::WHITE, textScale);
+		DrawString(0, line++ * lineDistance,
+			std::string("Precision: ") + (bDoubleDoublePrecision ? "double-double" : bFloatPrecision ? "float" : "double") + (bAutoFloat ? " (automatic, P for double only)" : " (double only, P for automatic)"), olc::WHITE, textScale);
+		DrawString(0, line++ * lineDistance,
+			std::string("Pan reuse: ") + (bPanReuse ? "on" : "off") + " (D)" + (bPanReused ? ", last frame shifted by the pan" : ""), olc::WHITE, textScale);
+		if (bReferenceOrbitUsed)
+			DrawString(0, line++ * lineDistance,
+				"Perturbation reference orbit: " + std::to_string(referenceOrbit.zx.size()) + " iterations, " + std::to_string(referenceOrbit.nBits) + " bits" + (referenceOrbit.bNucleus ? ", at the nucleus" : "") + ", " + referenceOrbit.sOrigin, olc::WHITE, textScale);
+		if (nucleus.nPeriod > 0)
+			DrawString(0, line++ * lineDistance,
+				"Nucleus (N at the mouse, or nearest the center for perturbation): period " + std::to_string(nucleus.nPeriod) + " at " + DoubleDoubleToString(nucleus.x) + ", " + DoubleDoubleToString(nucleus.y) + ", " + std::to_string(nucleus.nNewtonSteps) + " Newton steps", olc::WHITE, textScale);
+		if (nSeriesSkippedIterations > 0)
+			DrawString(0, line++ * lineDistance,
+				"Series approximation skipped iterations: " + std::to_string(nSeriesSkippedIterations) + ", " + std::to_string(nSeriesSkippedIterations / ((int64_t)ScreenWidth() * ScreenHeight())) + " per pixel", olc::WHITE, textScale);
+		if (nBlaSkippedIterations > 0)
+			DrawString(0, line++ * lineDistance,
+				"BLA skipped iterations: " + std::to_string(nBlaSkippedIterations) + ", " + std::to_string(nBlaSkippedIterations / ((int64_t)ScreenWidth() * ScreenHeight())) + " per pixel", olc::WHITE, textScale);
+		if (nRebasedPixels > 0)
+			DrawString(0, line++ * lineDistance,
+				"Glitched pixels rebased: " + std::to_string(nRebasedPixels), olc::WHITE, textScale);
+		if (nReferenceEndPixels > 0)
+			DrawString(0, line++ * lineDistance,
+				"Pixels outliving the reference, rebased at its end: " + std::to_string(nReferenceEndPixels), olc::WHITE, textScale);
+		if (nUncertainBlaPixels > 0)
+			DrawString(0, line++ * lineDistance,
+				"Uncertain pixels calculated again without BLA: " + std::to_string(nUncertainBlaPixels) + ", in 128 bit fixed point: " + std::to_string(nUncertainPixels), olc::WHITE, textScale);
+		if (nFilledPixels > 0)
+			DrawString(0, line++ * lineDistance,
+				"Filled pixels: " + std::to_string(nFilledPixels) + ", " + std::to_string(100 * nFilledPixels / ((int64_t)ScreenWidth() * ScreenHeight())) + "% not calculated", olc::WHITE, textScale);
+#if defined(__GNUG__) || defined(USE_TBB_WITH_MSC)
+		if (DrawFunctions[nCurrentDrawFunctionIndex].pDrawFunction == &PgeMandelbrotParallel::DrawTBBProgressive)
+			DrawString(0, line++ * lineDistance,
+				"Progressive refinement: " + (nProgressiveStep > 0 ? std::to_string(nProgressiveStep) + "x" + std::to_string(nProgressiveStep) + " blocks, row " + std::to_string(nProgressiveRow) : std::string("complete")), olc::WHITE, textScale);
+		if (DrawFunctions[nCurrentDrawFunctionIndex].pDrawFunction == &PgeMandelbrotParallel::DrawTBBSolidGuessing)
+			DrawString(0, line++ * lineDistance,
+				"Solid guessing verification level: " + std::to_string(nGuessingVerification) + " (L)", olc::WHITE, textScale);
+#endif
+		if (!sCheckResult.empty())
+			DrawString(0, line++ * lineDistance, sCheckResult, olc::WHITE, textScale);
 
 		return true;
 	}
@@ -462,6 +3614,45 @@ std::vector<PgeMandelbrotParallel::DrawFunctionDescription> PgeMandelbrotParalle
 #if defined(_MSC_VER)
 	{ olc::Key::K5, "5", "Microsoft PPL parallel_for", &PgeMandelbrotParallel::DrawPPLParallelFor},
 #endif
+	{ olc::Key::K6, "6", "OpenMP drawing, SIMD kernel", &PgeMandelbrotParallel::DrawOpenMPSIMD},
+	{ olc::Key::K7, "7", "C++17 parallel for_each drawing, SIMD kernel", &PgeMandelbrotParallel::DrawCpp17ForEachSIMD},
+#if defined(__GNUG__)  || defined(USE_TBB_WITH_MSC)
+	{ olc::Key::K8, "8", "oneTBB parallel_for, SIMD kernel", &PgeMandelbrotParallel::DrawTBBParallelForSIMD},
+#endif
+#if defined(_MSC_VER)
+	{ olc::Key::K9, "9", "Microsoft PPL parallel_for, SIMD kernel", &PgeMandelbrotParallel::DrawPPLParallelForSIMD},
+#endif
+#if (defined(__GNUG__)  || defined(USE_TBB_WITH_MSC)) && defined(USE_X86_SIMD)
+	{ olc::Key::F1, "F1", "oneTBB parallel_for, AVX-512 8 doubles", &PgeMandelbrotParallel::DrawTBBParallelForAVX512},
+	{ olc::Key::F2, "F2", "oneTBB parallel_for, AVX-512 16 floats", &PgeMandelbrotParallel::DrawTBBParallelForAVX512Float},
+#endif
+#if defined(__GNUG__)  || defined(USE_TBB_WITH_MSC)
+	{ olc::Key::F3, "F3", "oneTBB parallel_for, scalar 4 pixels interleaved", &PgeMandelbrotParallel::DrawTBBParallelForInterleaved},
+#if defined(USE_STD_SIMD)
+	{ olc::Key::F4, "F4", "oneTBB parallel_for, std::simd escape test per 4 iterations", &PgeMandelbrotParallel::DrawTBBParallelForBlocked<RowKernel::Blocked4, RowKernel::Blocked4Float>},
+	{ olc::Key::F5, "F5", "oneTBB parallel_for, std::simd escape test per 8 iterations", &PgeMandelbrotParallel::DrawTBBParallelForBlocked<RowKernel::Blocked8, RowKernel::Blocked8Float>},
+	{ olc::Key::F6, "F6", "oneTBB parallel_for, std::simd escape test per 16 iterations", &PgeMandelbrotParallel::DrawTBBParallelForBlocked<RowKernel::Blocked16, RowKernel::Blocked16Float>},
+#endif
+	{ olc::Key::F7, "F7", "oneTBB parallel_for, 128 bit fixed point", &PgeMandelbrotParallel::DrawTBBParallelForFixed128},
+	{ olc::Key::F8, "F8", "oneTBB parallel_for, perturbation", &PgeMandelbrotParallel::DrawTBBParallelForPerturbation, &PgeMandelbrotParallel::DrawTBBParallelForSIMD},
+	{ olc::Key::F10, "F10", "oneTBB parallel_for tiles, perturbation with series approximation", &PgeMandelbrotParallel::DrawTBBParallelForSeries, &PgeMandelbrotParallel::DrawTBBParallelForSIMD},
+	{ olc::Key::F11, "F11", "oneTBB parallel_for, perturbation with BLA", &PgeMandelbrotParallel::DrawTBBParallelForBla, &PgeMandelbrotParallel::DrawTBBParallelForSIMD},
+	{ olc::Key::F12, "F12", "oneTBB parallel_for, perturbation with BLA and glitch rebasing", &PgeMandelbrotParallel::DrawTBBParallelForRebasing, &PgeMandelbrotParallel::DrawTBBParallelForSIMD},
+	{ olc::Key::S, "S", "oneTBB tasks, Mariani-Silver subdivision, SIMD kernel", &PgeMandelbrotParallel::DrawTBBMarianiSilver},
+	{ olc::Key::G, "G", "oneTBB parallel_for, boundary tracing of tiles, SIMD kernel", &PgeMandelbrotParallel::DrawTBBBoundaryTrace},
+	{ olc::Key::O, "O", "oneTBB parallel_for, progressive refinement over frames, SIMD kernel", &PgeMandelbrotParallel::DrawTBBProgressive},
+	{ olc::Key::E, "E", "oneTBB parallel_for, solid guessing quadtrees, SIMD kernel", &PgeMandelbrotParallel::DrawTBBSolidGuessing},
+#endif
+	{ olc::Key::F9, "F9", "OpenMP drawing, perturbation", &PgeMandelbrotParallel::DrawOpenMPPerturbation, &PgeMandelbrotParallel::DrawOpenMPSIMD},
+};
+
+std::vector<PgeMandelbrotParallel::FormulaDescription> PgeMandelbrotParallel::Formulas
+{
+	DescribeFormula<MandelbrotFormula>(olc::Key::M, "M", "Mandelbrot z^2 + c"),
+	DescribeFormula<BurningShipFormula>(olc::Key::B, "B", "Burning Ship (|x| + i|y|)^2 + c"),
+	DescribeFormula<TricornFormula>(olc::Key::T, "T", "Tricorn conj(z)^2 + c"),
+	DescribeFormula<MultibrotFormula<3>>(olc::Key::U, "U", "Multibrot z^3 + c"),
+	DescribeFormula<MultibrotFormula<4>>(olc::Key::V, "V", "Multibrot z^4 + c"),
 };
 
 int main()
@@ -0,0 +1,152 @@
+/*
+This code is:
+
+Copyright 2024 - 2025 Frank B. Jakobsen
+
+It is released under the same license as PgeMandelbrotParallel.cpp, the OLC 3
+
+A screen to world transformation with the pan and zoom of olc::TransformedView,
+but templated on the type T of the world coordinates.
+
+olc::TransformedView keeps the world offset and scale in float, which ends the zoom at about 1e-7.
+Here the world offset, the world position of the top left corner of the screen, is a T, and the scale,
+in pixels per world unit, is a double. All positions on the screen are within a screen of pixels from the
+offset, so their differences from it are calculated in double, and only added to the offset in T.
+T is double or DoubleDouble. The zoom ends where T can no longer hold the pixel spacing relative to the offset,
+about 1e-30 for DoubleDouble.
+*/
+
+#pragma once
+
+#include "olcPixelGameEngine.h"
+#include "DoubleDouble.h"
+
+#include <type_traits>
+
+inline double ToDouble(double d)
+{
+	return d;
+}
+
+template <typename T>
+struct Vector2T
+{
+	T x;
+	T y;
+};
+
+template <typename T>
+class TransformedViewT : public olc::PGEX
+{
+	static_assert(std::is_same_v<T, double> || std::is_same_v<T, DoubleDouble>, "TransformedViewT is for double and DoubleDouble");
+
+public:
+	TransformedViewT() = default;
+
+	void Initialise(const olc::vi2d& viewArea, const olc::vd2d& scale = { 1.0, 1.0 })
+	{
+		vViewArea = viewArea;
+		vWorldScale = scale;
+	}
+
+	void SetWorldOffset(const Vector2T<T>& offset)
+	{
+		vWorldOffset = offset;
+	}
+
+	// The world position of the top left corner of the screen, in full precision
+	const Vector2T<T>& GetPreciseWorldOffset() const
+	{
+		return vWorldOffset;
+	}
+
+	// The world position of the top left corner of the screen, rounded to double
+	olc::vd2d GetWorldOffset() const
+	{
+		return { ToDouble(vWorldOffset.x), ToDouble(vWorldOffset.y) };
+	}
+
+	const olc::vd2d& GetWorldScale() const
+	{
+		return vWorldScale;
+	}
+
+	olc::vd2d ScreenToWorld(const olc::vd2d& screenPos) const
+	{
+		return { ToDouble(vWorldOffset.x + screenPos.x / vWorldScale.x), ToDouble(vWorldOffset.y + screenPos.y / vWorldScale.y) };
+	}
+
+	olc::vd2d GetWorldTL() const
+	{
+		return ScreenToWorld({ 0.0, 0.0 });
+	}
+
+	olc::vd2d GetWorldBR() const
+	{
+		return ScreenToWorld(olc::vd2d(vViewArea));
+	}
+
+	// Zoom with the world position at the screen position fixed,
+	// the offset moves by the difference of that position from it before and after the zoom
+	void ZoomAtScreenPos(double deltaZoom, const olc::vd2d& pos)
+	{
+		olc::vd2d before = pos / vWorldScale;
+		vWorldScale *= deltaZoom;
+		olc::vd2d after = pos / vWorldScale;
+		vWorldOffset.x = vWorldOffset.x + (before.x - after.x);
+		vWorldOffset.y = vWorldOffset.y + (before.y - after.y);
+	}
+
+	void StartPan(const olc::vi2d& pos)
+	{
+		bPanning = true;
+		vStartPan = olc::vd2d(pos);
+	}
+
+	void UpdatePan(const olc::vi2d& pos)
+	{
+		if (bPanning)
+		{
+			olc::vd2d delta = (olc::vd2d(pos) - vStartPan) / vWorldScale;
+			vWorldOffset.x = vWorldOffset.x - delta.x;
+			vWorldOffset.y = vWorldOffset.y - delta.y;
+			vStartPan = olc::vd2d(pos);
+		}
+	}
+
+	void EndPan(const olc::vi2d& pos)
+	{
+		UpdatePan(pos);
+		bPanning = false;
+	}
+
+	bool IsPanning() const
+	{
+		return bPanning;
+	}
+
+	// The same mouse handling as olc::TransformedView
+	void HandlePanAndZoom(const int nMouseButton = 2, const double zoomRate = 0.1, const bool bPan = true, const bool bZoom = true)
+	{
+		const auto& mousePos = pge->GetMousePos();
+		if (bPan)
+		{
+			if (pge->GetMouse(nMouseButton).bPressed) StartPan(mousePos);
+			if (pge->GetMouse(nMouseButton).bHeld) UpdatePan(mousePos);
+			if (pge->GetMouse(nMouseButton).bReleased) EndPan(mousePos);
+		}
+
+		if (bZoom)
+		{
+			if (pge->GetMouseWheel() > 0) ZoomAtScreenPos(1.0 + zoomRate, mousePos);
+			if (pge->GetMouseWheel() < 0) ZoomAtScreenPos(1.0 - zoomRate, mousePos);
+		}
+	}
+
+private:
+	Vector2T<T> vWorldOffset{ T(0.0), T(0.0) };
+	olc::vd2d vWorldScale = { 1.0, 1.0 };
+	olc::vi2d vViewArea;
+	bool bPanning = false;
+	olc::vd2d vStartPan = { 0.0, 0.0 };
+};
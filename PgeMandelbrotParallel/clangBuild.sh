@@ -1 +1 @@
-clang++ -fopenmp -lomp -std=c++17 -O3 -lpng -lX11 -lGL PgeMandelbrotParallel.cpp -ltbb -o CLangPgeMandelbrotParallel
+clang++ -fopenmp -lomp -std=c++17 -O3 -ffp-contract=off -lpng -lX11 -lGL PgeMandelbrotParallel.cpp -ltbb -o CLangPgeMandelbrotParallel
@@ -1 +1 @@
-g++  PgeMandelbrotParallel.cpp -fopenmp -lX11 -lGL -lpthread -lpng -lstdc++fs -std=c++17 -O3 -ltbb -o PgeMandelbrotParallel
\ No newline at end of file
+g++  PgeMandelbrotParallel.cpp -fopenmp -lX11 -lGL -lpthread -lpng -lstdc++fs -std=c++17 -O3 -ffp-contract=off -ltbb -o PgeMandelbrotParallel
\ No newline at end of file
@@ -1 +1 @@
-g++ PgeMandelbrotParallel.cpp -Wall -fopenmp -std=c++17 -O3 -luser32 -lgdi32 -lopengl32 -lgdiplus -lShlwapi -ldwmapi -lstdc++fs -ltbb12 -o PgeMandelbrotParallel.exe
+g++ PgeMandelbrotParallel.cpp -Wall -fopenmp -std=c++17 -O3 -ffp-contract=off -luser32 -lgdi32 -lopengl32 -lgdiplus -lShlwapi -ldwmapi -lstdc++fs -ltbb12 -o PgeMandelbrotParallel.exe